@@ -4,14 +4,18 @@
 #include "SimpleAnimComponent.h"
 
 #include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/MovementComponent.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(SimpleAnimComponent)
 
 USimpleAnimComponent::USimpleAnimComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	PrimaryComponentTick.bCanEverTick = false;
+	// Only ticks when bProduceSnapshotInMovementTick
+	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
 }
 
 void USimpleAnimComponent::OnRegister()
@@ -36,4 +40,63 @@ void USimpleAnimComponent::PostLoad()
 	Super::PostLoad();
 
 	SetUpdatedCharacter();
+}
+
+void USimpleAnimComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bProduceSnapshotInMovementTick)
+	{
+		if (UActorComponent* MovementComponent = GetSimpleMovementTickComponent())
+		{
+			AddTickPrerequisiteComponent(MovementComponent);
+			SetComponentTickEnabled(true);
+		}
+	}
+}
+
+void USimpleAnimComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(USimpleAnimComponent::ProduceSimpleSnapshot);
+
+	// Write to the slot the reader is not using, then publish it
+	const uint64 Published = PublishedSnapshot.load(std::memory_order_relaxed);
+	const uint64 WriteIndex = Published == MAX_uint64 ? 0 : (~Published & 1);
+
+	ProduceSimpleSnapshot(SnapshotBuffers[WriteIndex]);
+
+	PublishedSnapshot.store((GFrameCounter << 1) | WriteIndex, std::memory_order_release);
+}
+
+UActorComponent* USimpleAnimComponent::GetSimpleMovementTickComponent() const
+{
+	return GetOwner() ? GetOwner()->FindComponentByClass<UMovementComponent>() : nullptr;
+}
+
+FSimpleLocomotionSnapshot* USimpleAnimComponent::GetPublishedSimpleSnapshot()
+{
+	const uint64 Published = PublishedSnapshot.load(std::memory_order_acquire);
+	if (Published == MAX_uint64 || (Published >> 1) != GFrameCounter)
+	{
+		return nullptr;
+	}
+	return &SnapshotBuffers[Published & 1];
+}
+
+void USimpleAnimComponent::SetSimpleGatherFunction(FSimpleGatherFunction InGatherFunction, UObject* InOwner,
+	UObject* InMovement)
+{
+	const bool bValid = InGatherFunction && InOwner && InMovement;
+	SimpleGatherFunction = bValid ? InGatherFunction : nullptr;
+	SimpleBoundOwner = bValid ? InOwner : nullptr;
+	SimpleBoundMovement = bValid ? InMovement : nullptr;
+}
+
+void USimpleAnimComponent::GatherSimpleSnapshot(FSimpleLocomotionSnapshot& Snapshot) const
+{
+	GatherSimpleSnapshotFor(*this, *GetOwner(), Snapshot);
 }
\ No newline at end of file
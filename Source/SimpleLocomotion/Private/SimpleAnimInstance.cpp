@@ -5,12 +5,20 @@
 
 #include "SimpleAnimComponent.h"
 #include "SimpleAnimInstanceProxy.h"
+#include "SimpleAnimRecorder.h"
+#include "SimpleBakedRootMotion.h"
 #include "SimpleStatics.h"
 #include "SimpleTags.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/Pawn.h"
+#include "Engine/World.h"
 
 #include "Logging/MessageLog.h"
 
+#if WITH_EDITOR
+#include "UObject/ObjectSaveContext.h"
+#endif
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(SimpleAnimInstance)
 
 // DEFINE_LOG_CATEGORY_STATIC(LogSimpleAnim, Log, All);
@@ -47,6 +55,11 @@ namespace SimpleAnimInstanceCVars
 USimpleAnimInstance::USimpleAnimInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	// Packed flags cannot use default member initializers, the remainder are zero initialized with the object
+	bIsCurrentFloorWalkable = true;
+	bIsMovingOnGround = true;
+	bFirstUpdate = true;
+	
 	Gait = FSimpleTags::Simple_Gait_Run;
 	GaitSpeed = FSimpleTags::Simple_Gait_Run;
 	StartGait = FSimpleTags::Simple_Gait_Run;
@@ -60,6 +73,72 @@ FAnimInstanceProxy* USimpleAnimInstance::CreateAnimInstanceProxy()
 	return new FSimpleAnimInstanceProxy(this);
 }
 
+#if WITH_EDITOR
+void USimpleAnimInstance::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return;
+	}
+
+	// Cardinals is left as authored, only cooked builds apply the stripped modes when building the shared configuration
+	CookStrippedCardinalModes.Reset();
+	if (!SaveContext.IsCooking() || !bStripUnusedCardinalModesOnCook || !bHasScannedCardinalModes)
+	{
+		return;
+	}
+
+	// Disable the modes nothing references so they aren't computed every update in cooked builds
+	for (const auto& CardinalItr : Cardinals.GetDefaultCardinals())
+	{
+		if (CardinalItr.Value.bEnabled && !ReferencedCardinalModes.HasTagExact(CardinalItr.Key))
+		{
+			CookStrippedCardinalModes.AddTag(CardinalItr.Key);
+		}
+	}
+}
+
+void USimpleAnimInstance::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Rebuilt from the new defaults the next time an instance initializes
+	SharedCardinalConfig.Reset();
+}
+#endif
+
+TSharedRef<const FSimpleCardinalConfig> USimpleAnimInstance::GetSharedCardinalConfig() const
+{
+	check(IsInGameThread());
+	
+	const USimpleAnimInstance* CDO = GetClass()->GetDefaultObject<USimpleAnimInstance>();
+	if (!CDO->SharedCardinalConfig.IsValid())
+	{
+		const TMap<FGameplayTag, FSimpleCardinal>* CardinalConfig = &CDO->Cardinals.GetDefaultCardinals();
+
+		// Modes stripped on cook, the editor and uncooked builds always use the authored modes
+		TMap<FGameplayTag, FSimpleCardinal> UsedCardinals;
+		if (FPlatformProperties::RequiresCookedData() && !CDO->CookStrippedCardinalModes.IsEmpty())
+		{
+			UsedCardinals = *CardinalConfig;
+			for (auto& CardinalItr : UsedCardinals)
+			{
+				if (CDO->CookStrippedCardinalModes.HasTagExact(CardinalItr.Key))
+				{
+					CardinalItr.Value.bEnabled = false;
+				}
+			}
+			CardinalConfig = &UsedCardinals;
+		}
+
+		CDO->SharedCardinalConfig = FSimpleCardinalConfig::Build(*CardinalConfig,
+			[CDO](const FGameplayTag& CardinalMode) { return CDO->GetCardinalDeadZone(CardinalMode); });
+	}
+	return CDO->SharedCardinalConfig.ToSharedRef();
+}
+
 bool USimpleAnimInstance::IsLODEnabled(int32 LODThreshold) const
 {
 	const int32 LODLevel = AnimInstanceProxy->GetLODLevel();
@@ -80,21 +159,60 @@ void USimpleAnimInstance::NativeInitializeAnimation()
 	// Check optional initialization of owner
 	bOwnerHasInitialized = OwnerComponent->GetSimpleOwnerHasInitialized();
 
+	// Track montages through events instead of walking the montage instances every frame
+	NumActiveMontages = 0;
+	OnMontageStarted.AddUniqueDynamic(this, &ThisClass::OnSimpleMontageStarted);
+	OnMontageEnded.AddUniqueDynamic(this, &ThisClass::OnSimpleMontageEnded);
+
 	// Bind cardinal update delegates
-	for (auto& CardinalItr : Cardinals.GetCardinals())
+	BindCardinalUpdates();
+
+	bFirstUpdate = true;
+}
+
+void USimpleAnimInstance::BindCardinalUpdates()
+{
+	// Configuration is shared by the class, each instance only keeps its results
+	const TSharedRef<const FSimpleCardinalConfig> Config = GetSharedCardinalConfig();
+	if (Cardinals.GetConfig().Get() != &Config.Get())
 	{
-		FSimpleCardinal& Cardinal = CardinalItr.Value;
-		if (Cardinal.bEnabled && !Cardinal.UpdateDelegate.IsBoundToObject(this))
-		{
-			Cardinal.UpdateDelegate.BindUObject(this, &ThisClass::UpdateCardinal);
-		}
+		Cardinals.SetConfig(Config);
+	}
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		Cardinals.ReleaseDefaultCardinals();
 	}
 
-	bFirstUpdate = true;
+	if (!Cardinals.UpdateDelegate.IsBoundToObject(this))
+	{
+		Cardinals.UpdateDelegate.BindUObject(this, &ThisClass::UpdateCardinal);
+	}
 }
 
 void USimpleAnimInstance::NativeBeginPlay()
 {
+	// Update after the component has produced this frame's snapshot
+	if (OwnerComponent && OwnerComponent->WantsProduceSnapshotInMovementTick())
+	{
+		if (USkeletalMeshComponent* Mesh = GetSkelMeshComponent())
+		{
+			Mesh->AddTickPrerequisiteComponent(OwnerComponent);
+		}
+	}
+	
+	// Net mode cannot change after begin play, role and local control only change with the controller or role
+	bDedicatedServer = IsRunningDedicatedServer() || (Owner && Owner->GetNetMode() == NM_DedicatedServer);
+	RefreshNetworkState();
+	if (PawnOwner)
+	{
+		PawnOwner->ReceiveControllerChangedDelegate.AddUniqueDynamic(this, &ThisClass::OnPawnControllerChanged);
+	}
+	if (OwnerComponent)
+	{
+		OwnerComponent->OnSimpleNetRoleChanged.RemoveAll(this);
+		OwnerComponent->OnSimpleNetRoleChanged.AddUObject(this, &ThisClass::RefreshNetworkState);
+	}
+	
 	// Bind landed delegate -- cannot do this in NativeInitializeAnimation because the owner is CD0 there
 	if (FSimpleLandedSignature* LandedDelegatePtr = OwnerComponent->GetSimpleOnLandedDelegate())
 	{
@@ -106,6 +224,31 @@ void USimpleAnimInstance::NativeBeginPlay()
 	}
 }
 
+void USimpleAnimInstance::RefreshNetworkState()
+{
+	// Refreshed again once the owner initializes
+	if (OwnerComponent && bOwnerHasInitialized)
+	{
+		LocalRole = OwnerComponent->GetSimpleLocalRole();
+		bLocallyControlled = OwnerComponent->GetSimpleIsLocallyControlled();
+	}
+}
+
+void USimpleAnimInstance::OnPawnControllerChanged(APawn* Pawn, AController* OldController, AController* NewController)
+{
+	RefreshNetworkState();
+}
+
+void USimpleAnimInstance::OnSimpleMontageStarted(UAnimMontage* Montage)
+{
+	NumActiveMontages++;
+}
+
+void USimpleAnimInstance::OnSimpleMontageEnded(UAnimMontage* Montage, bool bInterrupted)
+{
+	NumActiveMontages = FMath::Max(0, NumActiveMontages - 1);
+}
+
 void USimpleAnimInstance::NativeUpdateAnimation(float DeltaTime)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(USimpleAnimInstance::NativeUpdateAnimation);
@@ -115,64 +258,163 @@ void USimpleAnimInstance::NativeUpdateAnimation(float DeltaTime)
 		if (!bOwnerHasInitialized && IsValid(Owner) && OwnerComponent)
 		{
 			bOwnerHasInitialized = OwnerComponent->GetSimpleOwnerHasInitialized();
+			if (bOwnerHasInitialized)
+			{
+				RefreshNetworkState();
+			}
 		}
 		return;
 	}
 
+	// Use this frame's inputs if the component produced them during the movement tick, otherwise gather them now
+	FSimpleLocomotionSnapshot GatheredSnapshot;
+	FSimpleLocomotionSnapshot* Snapshot = OwnerComponent->GetPublishedSimpleSnapshot();
+	if (!Snapshot)
+	{
+		Snapshot = &GatheredSnapshot;
+		OwnerComponent->ProduceSimpleSnapshot(GatheredSnapshot);
+	}
+	Snapshot->LocalRole = LocalRole;
+	Snapshot->bDedicatedServer = bDedicatedServer;
+	Snapshot->bLocallyControlled = bLocallyControlled;
+	Snapshot->bIsAnyMontagePlaying = NumActiveMontages > 0;
+
+	ApplySnapshot(*Snapshot);
+
+	UpdateGroundDistance(DeltaTime);
+
+#if SIMPLE_ANIM_RECORDING
+	if (FSimpleAnimRecorder::IsRecording())
+	{
+		FSimpleAnimRecorder::Get().Record(this, *Snapshot, DeltaTime);
+	}
+#endif
+}
+
+void USimpleAnimInstance::UpdateGroundDistance(float DeltaTime)
+{
+	UWorld* OwnerWorld = Owner->GetWorld();
+	
+	// Skip entirely when grounded, any pending result is discarded
+	if (!bWantsGroundDistanceUpdated || !bInAir || !OwnerWorld)
+	{
+		GroundDistance = 0.f;
+		GroundProbeHandle.Invalidate();
+		TimeUntilGroundProbe = 0.f;
+		return;
+	}
+
+	// Consume last frame's result
+	if (GroundProbeHandle.IsValid())
+	{
+		FTraceDatum TraceDatum;
+		if (OwnerWorld->QueryTraceData(GroundProbeHandle, TraceDatum))
+		{
+			GroundProbeHandle.Invalidate();
+			const float HalfHeight = OwnerComponent->GetSimpleGroundProbeHalfHeight();
+			const FHitResult* Hit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Result) { return Result.bBlockingHit; });
+			GroundDistance = Hit ? FMath::Max(0.f, static_cast<float>(Hit->Distance) - HalfHeight) : GroundProbeMaxDistance;
+		}
+		else if (!OwnerWorld->IsTraceHandleValid(GroundProbeHandle, false))
+		{
+			GroundProbeHandle.Invalidate();
+		}
+	}
+
+	TimeUntilGroundProbe -= DeltaTime;
+	if (GroundProbeHandle.IsValid() || TimeUntilGroundProbe > 0.f)
+	{
+		return;
+	}
+
+	// Probe again once we could have covered the remaining distance, the result arrives next frame
+	// While rising the ground can only get further away, so wait until near the apex
+	const float VerticalSpeed = FMath::Abs(World.Velocity.Z);
+	const float TimeToGround = VerticalSpeed > UE_KINDA_SMALL_NUMBER ? GroundDistance / VerticalSpeed : GroundProbeMaxInterval;
+	TimeUntilGroundProbe = FMath::Min(FMath::Max(TimeToGround * 0.5f, TimeToJumpApex), GroundProbeMaxInterval);
+
+	const float HalfHeight = OwnerComponent->GetSimpleGroundProbeHalfHeight();
+	const FVector Start = Owner->GetActorLocation();
+	const FVector End = Start - FVector::UpVector * (HalfHeight + GroundProbeMaxDistance);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SimpleGroundProbe), false, Owner);
+
+	GroundProbeHandle = OwnerWorld->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End,
+		OwnerComponent->GetSimpleGroundProbeChannel(), QueryParams);
+}
+
+void USimpleAnimInstance::ApplySnapshot(const FSimpleLocomotionSnapshot& Snapshot)
+{
 	bWasMovingLastUpdate = !Local2D.Velocity.IsZero();
 	bWasMovingLastUpdateWall = bMovementOnWall && !Local.Velocity.IsZero();
 
-	LocalRole = OwnerComponent->GetSimpleLocalRole();
-	bDedicatedServer = IsRunningDedicatedServer() || OwnerComponent->GetNetMode() == NM_DedicatedServer;
-	bLocallyControlled = OwnerComponent->GetSimpleIsLocallyControlled();
+	LocalRole = Snapshot.LocalRole;
+	bDedicatedServer = Snapshot.bDedicatedServer;
+	bLocallyControlled = Snapshot.bLocallyControlled;
 
 	const FGameplayTag PrevState = State;
-	State = OwnerComponent->GetSimpleAnimState();
+	State = Snapshot.State;
 	bStateChanged = State != PrevState;
 
-	World.Velocity = OwnerComponent->GetSimpleVelocity();
-	World.Acceleration = OwnerComponent->GetSimpleAcceleration();
-	ForwardVector = Owner->GetActorForwardVector();
-	RightVector = Owner->GetActorRightVector();
+	WorldLocation = Snapshot.Location;
+	World.Velocity = Snapshot.Velocity;
+	World.Acceleration = Snapshot.Acceleration;
+	ForwardVector = Snapshot.ForwardVector;
+	RightVector = Snapshot.RightVector;
 
 	PrevWorldRotation = WorldRotation;
-	WorldRotation = Owner->GetActorRotation();
-	ControlRotation = OwnerComponent->GetSimpleControlRotation();
-	BaseAimRotation = OwnerComponent->GetSimpleBaseAimRotation();
+	WorldRotation = Snapshot.WorldRotation;
+	WorldQuat = Snapshot.WorldQuat;
+	ControlRotation = Snapshot.ControlRotation;
+	BaseAimRotation = Snapshot.BaseAimRotation;
 
 	PrevMaxSpeed = MaxSpeed;
-	MaxSpeed = OwnerComponent->GetSimpleMaxSpeed();
-	MaxGaitSpeeds = OwnerComponent->GetSimpleMaxGaitSpeeds();
-	LeanRate = LeanRateOverride >= 0.f ? LeanRateOverride : OwnerComponent->GetSimpleLeanRate();
-	StartLeanRate = StartLeanRateOverride >= 0.f ? StartLeanRateOverride : OwnerComponent->GetSimpleStartLeanRate();
+	MaxSpeed = Snapshot.MaxSpeed;
+	MaxGaitSpeeds = Snapshot.MaxGaitSpeeds;
+	LeanRate = LeanRateOverride >= 0.f ? LeanRateOverride : Snapshot.LeanRate;
+	StartLeanRate = StartLeanRateOverride >= 0.f ? StartLeanRateOverride : Snapshot.StartLeanRate;
 
-	RootYawOffset = OwnerComponent->GetSimpleRootYawOffset();
+	if (!bWantsTurnInPlaceUpdated)
+	{
+		RootYawOffset = Snapshot.RootYawOffset;
+	}
 
-	bIsCurrentFloorWalkable = OwnerComponent->IsSimpleCurrentFloorWalkable();
-	bIsMovingOnGround = OwnerComponent->GetSimpleIsMovingOnGround() && bIsCurrentFloorWalkable;
+	bIsCurrentFloorWalkable = Snapshot.bIsCurrentFloorWalkable;
+	bIsMovingOnGround = Snapshot.bIsMovingOnGround && bIsCurrentFloorWalkable;
 	bWasInAir = bInAir;
-	bInAir = OwnerComponent->GetSimpleIsFalling() || !bIsCurrentFloorWalkable;
-	bCanJump = OwnerComponent->GetSimpleCanJump();
-	GravityZ = OwnerComponent->GetSimpleGravityZ();
-	bMovementIs3D = OwnerComponent->GetSimpleMovementIs3D();
-	bMovementOnWall = OwnerComponent->GetSimpleMovementOnWall();
-
-	bIsCrouched = OwnerComponent->GetSimpleIsCrouched();
-	bIsProned = OwnerComponent->GetSimpleIsProned();
-
-	bIsStrolling = OwnerComponent->GetSimpleIsStrolling();
-	bIsWalking = OwnerComponent->GetSimpleIsWalking();
-	bIsSprinting = OwnerComponent->GetSimpleIsSprinting();
-
-	bWantsStrolling = OwnerComponent->GetSimpleWantsStrolling();
-	bWantsWalking = OwnerComponent->GetSimpleWantsWalking();
-	bWantsSprinting = OwnerComponent->GetSimpleWantsSprinting();
-
-	bWantsLandingFrameLock = OwnerComponent->WantsFrameLockOnLanding();
-	bIsMoveModeValid = OwnerComponent->GetSimpleIsMoveModeValid();
+	bInAir = Snapshot.bIsFalling || !bIsCurrentFloorWalkable;
+	bEnteredAir = bInAir && !bWasInAir;
+	bLanded = bWasInAir && !bInAir;
+	bCanJump = Snapshot.bCanJump;
+	GravityZ = Snapshot.GravityZ;
+	BrakingDeceleration = Snapshot.BrakingDeceleration;
+	BrakingFriction = Snapshot.BrakingFriction;
+	bMovementIs3D = Snapshot.bMovementIs3D;
+	bMovementOnWall = Snapshot.bMovementOnWall;
+
+	bIsCrouched = Snapshot.bIsCrouched;
+	bIsProned = Snapshot.bIsProned;
+
+	bIsStrolling = Snapshot.bIsStrolling;
+	bIsWalking = Snapshot.bIsWalking;
+	bIsSprinting = Snapshot.bIsSprinting;
+
+	bWantsStrolling = Snapshot.bWantsStrolling;
+	bWantsWalking = Snapshot.bWantsWalking;
+	bWantsSprinting = Snapshot.bWantsSprinting;
+
+	bWantsLandingFrameLock = Snapshot.bWantsLandingFrameLock;
+	bIsMoveModeValid = Snapshot.bIsMoveModeValid;
 	
-	bIsAnyMontagePlaying = IsAnyMontagePlaying();
-	bIsPlayingNetworkedRootMotionMontage = OwnerComponent->IsPlayingNetworkedRootMotionMontage();
+	bIsAnyMontagePlaying = Snapshot.bIsAnyMontagePlaying;
+	bIsPlayingNetworkedRootMotionMontage = Snapshot.bIsPlayingNetworkedRootMotionMontage;
+}
+
+void USimpleAnimInstance::InitializeForReplay()
+{
+	bIsReplaying = true;
+	bOwnerHasInitialized = true;
+	BindCardinalUpdates();
+	bFirstUpdate = true;
 }
 
 void USimpleAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaTime)
@@ -187,20 +429,24 @@ void USimpleAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaTime)
 	// Extension point
 	NativeThreadSafePreUpdateMovementProperties(DeltaTime);
 
-	// Movement properties
-	Local = World.GetLocal(WorldRotation);
-	Local2D = Local.Get2D();
-	World2D = World.Get2D();
+	// Movement properties, computed in single precision and only widened to FSimpleMovement for Blueprint
+	const FSimpleMovementPacked WorldPacked { World };
+	const FSimpleMovementPacked LocalPacked = WorldPacked.GetLocal(FSimpleMovementPacked::Load(WorldQuat));
+	const FSimpleMovementPacked Local2DPacked = LocalPacked.Get2D();
+	Local = LocalPacked.ToMovement();
+	Local2D = Local2DPacked.ToMovement();
+	World2D = WorldPacked.Get2D().ToMovement();
 
 	PrevSpeed = Speed;
-	Speed3D = Local.Velocity.Size();
-	Speed2D = Local2D.Velocity.Size();
+	const float Speed3DSq = LocalPacked.GetSpeedSquared();
+	const float Speed2DSq = Local2DPacked.GetSpeedSquared();
+	Speed3D = FMath::Sqrt(Speed3DSq);
+	Speed2D = FMath::Sqrt(Speed2DSq);
 	Speed = bIsMovingOnGround ? Speed3D : Speed2D;
-	const float SpeedSq = Speed * Speed;
-	const float Speed2DSq = Speed2D * Speed2D;
+	const float SpeedSq = bIsMovingOnGround ? Speed3DSq : Speed2DSq;
 
-	const float AccelMag3D = Local.Acceleration.SizeSquared();
-	const float AccelMag2D = Local2D.Acceleration.SizeSquared();
+	const float AccelMag3D = LocalPacked.GetAccelerationSquared();
+	const float AccelMag2D = Local2DPacked.GetAccelerationSquared();
 	const float AccelSq = bMovementIs3D ? AccelMag3D : AccelMag2D;
 	
 	bHasVelocity = !FMath::IsNearlyZero(SpeedSq);
@@ -215,8 +461,12 @@ void USimpleAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaTime)
 		BaseAimRotation = ControlRotation;
 	}
 
-	// Update cardinal properties
-	Cardinals.ThreadSafeUpdate(World2D, World, WorldRotation, bMovementOnWall);
+	// Update cardinal properties, UpdateCardinal takes the delta from here rather than the proxy, which replay doesn't initialize
+	CardinalDeltaTime = DeltaTime;
+	Cardinals.ThreadSafeUpdate(World2D, World, WorldQuat, bMovementOnWall);
+
+	// Predict stops and pivots, StopGait depends on these
+	NativeThreadSafeUpdateStopAndPivot(DeltaTime);
 
 	// Update gait modes
 	NativeThreadSafeUpdateGaitMode(DeltaTime);
@@ -224,6 +474,12 @@ void USimpleAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaTime)
 	// Update stance
 	NativeThreadSafeUpdateStance(DeltaTime);
 
+	// Turn in place
+	NativeThreadSafeUpdateTurnInPlace(DeltaTime);
+
+	// Orientation and stride warping, after cardinals
+	NativeThreadSafeUpdateWarping(DeltaTime);
+
 	// Extension point
 	NativeThreadSafePostUpdateMovementProperties(DeltaTime);
 
@@ -259,25 +515,35 @@ void USimpleAnimInstance::ThreadSafeUpdateLeanAngles(float DeltaTime)
 	if (bFirstUpdate)
 	{
 		// There is no valid delta on the first frame
+		LeanYawRate = 0.f;
 		LeanAngle = 0.f;
 		StartLeanAngle = 0.f;
 	}
 	else if (bWantsLeansUpdated)
 	{
-		// Compute lean delta
-		const float YawDelta = WorldRotation.Yaw - PrevWorldRotation.Yaw;
-		const float YawDeltaSpeed = YawDelta / DeltaTime;
+		if (DeltaTime > UE_KINDA_SMALL_NUMBER)
+		{
+			// Compute lean delta, unwound so crossing +/-180 doesn't spike
+			// DeltaTime is the time accumulated since our last update, which may span several frames
+			const float YawDelta = FMath::FindDeltaAngleDegrees(PrevWorldRotation.Yaw, WorldRotation.Yaw);
+			const float YawDeltaSpeed = YawDelta / DeltaTime;
+
+			// Exponential smoothing is exact for any DeltaTime, so the result is the same at any update rate
+			const float Alpha = LeanSmoothingTime > 0.f ? 1.f - FMath::Exp(-DeltaTime / LeanSmoothingTime) : 1.f;
+			LeanYawRate = FMath::Lerp(LeanYawRate, YawDeltaSpeed, Alpha);
+		}
 
 		// 3.75 is a friendlier number than 0.0375 for designers so we divide by 100
 		const float ScaledLeanRate = LeanRate / 100.f;  
 		const float ScaledStartLeanRate = StartLeanRate / 100.f;
 
 		// Apply lean rate
-		LeanAngle = YawDeltaSpeed * ScaledLeanRate;
-		StartLeanAngle = YawDeltaSpeed * ScaledStartLeanRate;
+		LeanAngle = LeanYawRate * ScaledLeanRate;
+		StartLeanAngle = LeanYawRate * ScaledStartLeanRate;
 	}
 	else
 	{
+		LeanYawRate = 0.f;
 		LeanAngle = 0.f;
 		StartLeanAngle = 0.f;
 	}
@@ -323,42 +589,137 @@ void USimpleAnimInstance::NativeThreadSafeUpdateGaitMode(float DeltaTime)
 	}
 	bGaitChanged = Gait != PrevGait;
 
-	const float MaxSpeedStroll = MaxGaitSpeeds.GetMaxSpeed(FSimpleTags::Simple_Gait_Stroll);
-	const float MaxSpeedWalk = MaxGaitSpeeds.GetMaxSpeed(FSimpleTags::Simple_Gait_Walk);
-	const float MaxSpeedRun = MaxGaitSpeeds.GetMaxSpeed(FSimpleTags::Simple_Gait_Run);
-	const float MaxSpeedSprint = MaxGaitSpeeds.GetMaxSpeed(FSimpleTags::Simple_Gait_Sprint);
+	// Gait Mode at Speed: Use the gait we are closest to, thresholds are only rebuilt when the speeds change
+	GaitClassifier.Update(MaxGaitSpeeds);
+	GaitSpeed = GaitClassifier.Classify(Speed, GaitSpeed, GaitSpeedHysteresis);
 
-	// Midpoints - use the gait we are closest to
-	const float MidSpeedWalk = (MaxSpeedWalk + MaxSpeedStroll) * 0.5f;
-	const float MidSpeedRun = (MaxSpeedRun + MaxSpeedWalk) * 0.5f;
-	const float MidSpeedSprint = (MaxSpeedSprint + MaxSpeedRun) * 0.5f;
-	
-	// Gait Mode at Speed: Use the current mode based on speed
-	GaitSpeed = Gait;
-	if (Speed < MidSpeedWalk)
+	// Stop Gait Mode: Use the previous mode, a pivot is decelerating so don't downgrade until it completes
+	if (bHasAcceleration && !bIsPivoting)
 	{
-		GaitSpeed = FSimpleTags::Simple_Gait_Stroll;
+		StopGait = GaitSpeed;  // We stop based on the speed we are at rather than intent
 	}
-	else if (Speed < MidSpeedRun)
+}
+
+void USimpleAnimInstance::NativeThreadSafeUpdateStopAndPivot(float DeltaTime)
+{
+	bIsStopping = false;
+	bIsPivoting = false;
+	PredictedStopDistance = 0.f;
+	PredictedStopTime = 0.f;
+	PredictedStopLocation = WorldLocation;
+	PredictedPivotDistance = 0.f;
+
+	if (!bWantsStopAndPivotUpdated || !bIsMovingOnGround || !bHasVelocity)
 	{
-		GaitSpeed = FSimpleTags::Simple_Gait_Walk;
+		return;
 	}
-	else if (Speed < MidSpeedSprint)
+
+	// Speed is 3D while on the ground
+	const FVector& Acceleration = World.Acceleration;
+	const FVector VelocityDir = World.Velocity.GetSafeNormal();
+
+	if (!bHasAcceleration)
+	{
+		// Braking to a stop, closed form so there is no need to simulate the braking
+		bIsStopping = USimpleStatics::PredictSimpleStop(Speed, BrakingDeceleration, BrakingFriction,
+			PredictedStopDistance, PredictedStopTime);
+		PredictedStopLocation = WorldLocation + VelocityDir * PredictedStopDistance;
+		return;
+	}
+
+	// Pivoting when acceleration opposes velocity
+	const float OpposingAccel = -(Acceleration | VelocityDir);
+	if (OpposingAccel > 0.f && (Acceleration.GetSafeNormal() | VelocityDir) <= PivotDirectionThreshold)
 	{
-		GaitSpeed = FSimpleTags::Simple_Gait_Run;
+		bIsPivoting = true;
+		PredictedPivotDistance = FMath::Square(Speed) / (2.f * OpposingAccel);
+	}
+}
+
+void USimpleAnimInstance::NativeThreadSafeUpdateTurnInPlace(float DeltaTime)
+{
+	if (!bWantsTurnInPlaceUpdated)
+	{
+		return;
+	}
+
+	const bool bIdle = bIsMovingOnGround && !bHasAcceleration && !bHasVelocity;
+	if (bFirstUpdate || !bIdle)
+	{
+		// Blend out so the mesh follows the actor again, exact for any DeltaTime
+		const float Alpha = !bFirstUpdate && RootYawOffsetBlendOutTime > 0.f ? 1.f - FMath::Exp(-DeltaTime / RootYawOffsetBlendOutTime) : 1.f;
+		RootYawOffset = FMath::Lerp(RootYawOffset, 0.f, Alpha);
+		PrevRemainingTurnYaw = 0.f;
+		bTurnInPlaceRequested = false;
+		bIsTurningInPlace = false;
+		TurnInPlaceCardinal = FGameplayTag::EmptyTag;
+		TurnInPlaceAnimation = nullptr;
+		return;
+	}
+
+	// Counter-rotate so the mesh stays in place while the actor turns
+	const float YawDelta = FMath::FindDeltaAngleDegrees(PrevWorldRotation.Yaw, WorldRotation.Yaw);
+	RootYawOffset = FRotator::NormalizeAxis(RootYawOffset - YawDelta);
+
+	// Consume the turn curve, the turn animation rotates the mesh back toward the actor
+	// Replay doesn't evaluate the graph, so there are no curves to read
+	const float TurnYawWeight = bIsReplaying ? 0.f : GetCurveValue(TurnYawWeightCurveName);
+	bIsTurningInPlace = !FMath::IsNearlyZero(TurnYawWeight);
+	if (bIsTurningInPlace)
+	{
+		// Dividing by the weight removes the effect of blending in and out of the turn
+		const float RemainingTurnYaw = GetCurveValue(RemainingTurnYawCurveName) / TurnYawWeight;
+		if (PrevRemainingTurnYaw != 0.f)
+		{
+			RootYawOffset -= RemainingTurnYaw - PrevRemainingTurnYaw;
+		}
+		PrevRemainingTurnYaw = RemainingTurnYaw;
 	}
 	else
 	{
-		GaitSpeed = FSimpleTags::Simple_Gait_Sprint;
+		PrevRemainingTurnYaw = 0.f;
 	}
 
-	// Stop Gait Mode: Use the previous mode
-	if (bHasAcceleration)
+	RootYawOffset = FMath::Clamp(RootYawOffset, -MaxRootYawOffset, MaxRootYawOffset);
+
+	// Select the turn while it isn't playing, it is held until the turn completes
+	if (!bIsTurningInPlace)
 	{
-		StopGait = GaitSpeed;  // We stop based on the speed we are at rather than intent
+		bTurnInPlaceRequested = FMath::Abs(RootYawOffset) > TurnInPlaceSet.AngleTolerance;
+		if (bTurnInPlaceRequested)
+		{
+			// Turn toward the actor, which is opposite to the offset
+			TurnInPlaceCardinal = USimpleStatics::SelectSimpleCardinalFromAngle(TurnInPlaceSet.Mode, -RootYawOffset, 0.f,
+				TurnInPlaceCardinal, false);
+			TurnInPlaceAnimation = TurnInPlaceSet.GetAnimation(TurnInPlaceCardinal);
+		}
 	}
 }
 
+void USimpleAnimInstance::NativeThreadSafeUpdateWarping(float DeltaTime)
+{
+	if (!WarpingCardinal.IsValid())
+	{
+		OrientationWarpAngle = 0.f;
+		StrideWarpScale = 1.f;
+		return;
+	}
+
+	OrientationWarpAngle = FRotator::NormalizeAxis(Cardinals.GetDirectionAngle(WarpingCardinalType) - WarpingAuthoredAngle);
+	StrideWarpScale = WarpingAuthoredSpeed > 0.f ?
+		FMath::Clamp(Speed / WarpingAuthoredSpeed, MinStrideWarpScale, MaxStrideWarpScale) : 1.f;
+}
+
+void USimpleAnimInstance::SetWarpingSource(const FSimpleStrafeLocoSet& Set, FGameplayTag Cardinal)
+{
+	WarpingCardinal = Cardinal;
+	WarpingCardinalType = Set.CardinalType;
+	WarpingAuthoredAngle = USimpleStatics::GetSimpleCardinalAngle(Cardinal);
+
+	const FSimpleBakedRootMotion* Baked = Cardinal.IsValid() ? FSimpleBakedRootMotion::Find(Set.GetAnimation(Cardinal)) : nullptr;
+	WarpingAuthoredSpeed = Baked ? Baked->GetAuthoredSpeed() : 0.f;
+}
+
 void USimpleAnimInstance::NativeThreadSafeUpdateStance(float DeltaTime)
 {
 	// Stance
@@ -434,23 +795,38 @@ float USimpleAnimInstance::GetCardinalDeadZone(const FGameplayTag& CardinalMode)
 void USimpleAnimInstance::UpdateCardinal(const FGameplayTag& CardinalMode, FSimpleCardinal& Cardinal, const FSimpleCardinals& InCardinals)
 {
 	// Consider not updating the properties you don't need to optimize performance!
-	const float DeadZone = GetCardinalDeadZone(CardinalMode);
+	const float DeadZone = InCardinals.GetConfig()->GetDeadZone(CardinalMode);
+	const float DeltaTime = CardinalDeltaTime;
 
 	// CardinalMode is Simple.Mode
 	
+	const FGameplayTag PrevAcceleration = Cardinal.Acceleration;
 	Cardinal.Acceleration = USimpleStatics::SelectSimpleCardinalFromAngle(
 		CardinalMode, InCardinals.Acceleration, DeadZone, Cardinal.Acceleration, bWasMovingLastUpdate);
+	Cardinal.AccelerationHistory.Update(PrevAcceleration, Cardinal.Acceleration, DeltaTime);
 	
+	const FGameplayTag PrevVelocity = Cardinal.Velocity;
 	Cardinal.Velocity = USimpleStatics::SelectSimpleCardinalFromAngle(
 		CardinalMode, InCardinals.Velocity, DeadZone, Cardinal.Velocity, bWasMovingLastUpdate);
+	Cardinal.VelocityHistory.Update(PrevVelocity, Cardinal.Velocity, DeltaTime);
 
 	if (bMovementOnWall)
 	{
+		const FGameplayTag PrevAccelerationWall = Cardinal.AccelerationWall;
 		Cardinal.AccelerationWall = USimpleStatics::SelectSimpleCardinalFromAngle(
 			CardinalMode, InCardinals.AccelerationWall, DeadZone, Cardinal.AccelerationWall, bWasMovingLastUpdateWall);
+		Cardinal.AccelerationWallHistory.Update(PrevAccelerationWall, Cardinal.AccelerationWall, DeltaTime);
 	
+		const FGameplayTag PrevVelocityWall = Cardinal.VelocityWall;
 		Cardinal.VelocityWall = USimpleStatics::SelectSimpleCardinalFromAngle(
 			CardinalMode, InCardinals.VelocityWall, DeadZone, Cardinal.VelocityWall, bWasMovingLastUpdateWall);
+		Cardinal.VelocityWallHistory.Update(PrevVelocityWall, Cardinal.VelocityWall, DeltaTime);
+	}
+	else
+	{
+		// Wall cardinals hold while off the wall, so they can't have changed this update
+		Cardinal.AccelerationWallHistory.ClearTransitionBits();
+		Cardinal.VelocityWallHistory.ClearTransitionBits();
 	}
 }
 
@@ -461,6 +837,12 @@ float USimpleAnimInstance::GetLocomotionCardinalAngle(ESimpleCardinalType Cardin
 
 bool USimpleAnimInstance::IsAnimValidToUpdate(float DeltaTime) const
 {
+	if (bIsReplaying)
+	{
+		// Replayed instances have no owner, the recorded snapshot stands in for it
+		return DeltaTime > 1e-6f;
+	}
+	
 	const bool bValid = IsValid(Owner) && OwnerComponent && bOwnerHasInitialized;
 	const bool bValidDeltaTime = DeltaTime > 1e-6f;
 
@@ -0,0 +1,354 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "SimpleAnimRecorder.h"
+
+#include "SimpleTypes.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSimpleAnimRecorder, Log, All);
+
+bool FSimpleAnimRecorder::bRecording = false;
+
+#if SIMPLE_ANIM_RECORDING
+namespace SimpleAnimRecorderCommands
+{
+	static FAutoConsoleCommand StartCommand(
+		TEXT("a.SimpleAnim.Record.Start"),
+		TEXT("Start recording the inputs of every SimpleAnimInstance. Optional: Filename"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FSimpleAnimRecorder::Get().StartRecording(Args.Num() > 0 ? Args[0] : FSimpleAnimRecorder::GetDefaultFilename());
+		})
+	);
+
+	static FAutoConsoleCommand StopCommand(
+		TEXT("a.SimpleAnim.Record.Stop"),
+		TEXT("Stop recording the inputs of every SimpleAnimInstance and finalize the file"),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FSimpleAnimRecorder::Get().StopRecording();
+		})
+	);
+}
+#endif
+
+FSimpleAnimRecordFrame FSimpleAnimRecordFrame::FromSnapshot(uint16 InStreamId, const FSimpleLocomotionSnapshot& Snapshot,
+	float InDeltaTime, TFunctionRef<uint16(const FGameplayTag&)> TagToIndex)
+{
+	using namespace SimpleAnimRecord;
+
+	FSimpleAnimRecordFrame Frame;
+	Frame.StreamId = InStreamId;
+	Frame.StateTag = TagToIndex(Snapshot.State);
+	Frame.DeltaTime = InDeltaTime;
+
+	Frame.Flags |= Snapshot.bDedicatedServer ? Flag_DedicatedServer : 0;
+	Frame.Flags |= Snapshot.bLocallyControlled ? Flag_LocallyControlled : 0;
+	Frame.Flags |= Snapshot.bIsCurrentFloorWalkable ? Flag_IsCurrentFloorWalkable : 0;
+	Frame.Flags |= Snapshot.bIsMovingOnGround ? Flag_IsMovingOnGround : 0;
+	Frame.Flags |= Snapshot.bIsFalling ? Flag_IsFalling : 0;
+	Frame.Flags |= Snapshot.bCanJump ? Flag_CanJump : 0;
+	Frame.Flags |= Snapshot.bMovementIs3D ? Flag_MovementIs3D : 0;
+	Frame.Flags |= Snapshot.bMovementOnWall ? Flag_MovementOnWall : 0;
+	Frame.Flags |= Snapshot.bIsCrouched ? Flag_IsCrouched : 0;
+	Frame.Flags |= Snapshot.bIsProned ? Flag_IsProned : 0;
+	Frame.Flags |= Snapshot.bIsStrolling ? Flag_IsStrolling : 0;
+	Frame.Flags |= Snapshot.bIsWalking ? Flag_IsWalking : 0;
+	Frame.Flags |= Snapshot.bIsSprinting ? Flag_IsSprinting : 0;
+	Frame.Flags |= Snapshot.bWantsStrolling ? Flag_WantsStrolling : 0;
+	Frame.Flags |= Snapshot.bWantsWalking ? Flag_WantsWalking : 0;
+	Frame.Flags |= Snapshot.bWantsSprinting ? Flag_WantsSprinting : 0;
+	Frame.Flags |= Snapshot.bIsMoveModeValid ? Flag_IsMoveModeValid : 0;
+	Frame.Flags |= Snapshot.bWantsLandingFrameLock ? Flag_WantsLandingFrameLock : 0;
+	Frame.Flags |= Snapshot.bIsAnyMontagePlaying ? Flag_IsAnyMontagePlaying : 0;
+	Frame.Flags |= Snapshot.bIsPlayingNetworkedRootMotionMontage ? Flag_IsPlayingNetworkedRootMotionMontage : 0;
+
+	Frame.Location = FVector3f(Snapshot.Location);
+	Frame.Velocity = FVector3f(Snapshot.Velocity);
+	Frame.Acceleration = FVector3f(Snapshot.Acceleration);
+	Frame.WorldRotation = FRotator3f(Snapshot.WorldRotation);
+	Frame.ControlRotation = FRotator3f(Snapshot.ControlRotation);
+	Frame.BaseAimRotation = FRotator3f(Snapshot.BaseAimRotation);
+
+	Frame.MaxSpeed = Snapshot.MaxSpeed;
+	Frame.LeanRate = Snapshot.LeanRate;
+	Frame.StartLeanRate = Snapshot.StartLeanRate;
+	Frame.RootYawOffset = Snapshot.RootYawOffset;
+	Frame.GravityZ = Snapshot.GravityZ;
+	Frame.BrakingDeceleration = Snapshot.BrakingDeceleration;
+	Frame.BrakingFriction = Snapshot.BrakingFriction;
+	Frame.LocalRole = static_cast<uint8>(Snapshot.LocalRole.GetValue());
+
+	for (const TPair<FGameplayTag, float>& GaitSpeed : Snapshot.MaxGaitSpeeds.MaxSpeeds)
+	{
+		if (Frame.NumGaitSpeeds >= MaxGaitSpeeds)
+		{
+			break;
+		}
+		Frame.GaitTags[Frame.NumGaitSpeeds] = TagToIndex(GaitSpeed.Key);
+		Frame.GaitSpeeds[Frame.NumGaitSpeeds] = GaitSpeed.Value;
+		Frame.NumGaitSpeeds++;
+	}
+
+	return Frame;
+}
+
+void FSimpleAnimRecordFrame::ToSnapshot(FSimpleLocomotionSnapshot& Snapshot, TConstArrayView<FGameplayTag> Tags) const
+{
+	using namespace SimpleAnimRecord;
+
+	auto GetTag = [&Tags](uint16 Index)
+	{
+		return Tags.IsValidIndex(Index) ? Tags[Index] : FGameplayTag::EmptyTag;
+	};
+
+	Snapshot.State = GetTag(StateTag);
+
+	Snapshot.bDedicatedServer = (Flags & Flag_DedicatedServer) != 0;
+	Snapshot.bLocallyControlled = (Flags & Flag_LocallyControlled) != 0;
+	Snapshot.bIsCurrentFloorWalkable = (Flags & Flag_IsCurrentFloorWalkable) != 0;
+	Snapshot.bIsMovingOnGround = (Flags & Flag_IsMovingOnGround) != 0;
+	Snapshot.bIsFalling = (Flags & Flag_IsFalling) != 0;
+	Snapshot.bCanJump = (Flags & Flag_CanJump) != 0;
+	Snapshot.bMovementIs3D = (Flags & Flag_MovementIs3D) != 0;
+	Snapshot.bMovementOnWall = (Flags & Flag_MovementOnWall) != 0;
+	Snapshot.bIsCrouched = (Flags & Flag_IsCrouched) != 0;
+	Snapshot.bIsProned = (Flags & Flag_IsProned) != 0;
+	Snapshot.bIsStrolling = (Flags & Flag_IsStrolling) != 0;
+	Snapshot.bIsWalking = (Flags & Flag_IsWalking) != 0;
+	Snapshot.bIsSprinting = (Flags & Flag_IsSprinting) != 0;
+	Snapshot.bWantsStrolling = (Flags & Flag_WantsStrolling) != 0;
+	Snapshot.bWantsWalking = (Flags & Flag_WantsWalking) != 0;
+	Snapshot.bWantsSprinting = (Flags & Flag_WantsSprinting) != 0;
+	Snapshot.bIsMoveModeValid = (Flags & Flag_IsMoveModeValid) != 0;
+	Snapshot.bWantsLandingFrameLock = (Flags & Flag_WantsLandingFrameLock) != 0;
+	Snapshot.bIsAnyMontagePlaying = (Flags & Flag_IsAnyMontagePlaying) != 0;
+	Snapshot.bIsPlayingNetworkedRootMotionMontage = (Flags & Flag_IsPlayingNetworkedRootMotionMontage) != 0;
+
+	Snapshot.Location = FVector(Location);
+	Snapshot.Velocity = FVector(Velocity);
+	Snapshot.Acceleration = FVector(Acceleration);
+	Snapshot.ControlRotation = FRotator(ControlRotation);
+	Snapshot.BaseAimRotation = FRotator(BaseAimRotation);
+
+	// Recordings don't store the basis, it is derived from the rotation
+	Snapshot.SetWorldQuat(FRotator(WorldRotation).Quaternion());
+	Snapshot.WorldRotation = FRotator(WorldRotation);
+
+	Snapshot.MaxSpeed = MaxSpeed;
+	Snapshot.LeanRate = LeanRate;
+	Snapshot.StartLeanRate = StartLeanRate;
+	Snapshot.RootYawOffset = RootYawOffset;
+	Snapshot.GravityZ = GravityZ;
+	Snapshot.BrakingDeceleration = BrakingDeceleration;
+	Snapshot.BrakingFriction = BrakingFriction;
+	Snapshot.LocalRole = static_cast<ENetRole>(LocalRole);
+
+	Snapshot.MaxGaitSpeeds.MaxSpeeds.Reset();
+	for (int32 i = 0; i < FMath::Min<int32>(NumGaitSpeeds, MaxGaitSpeeds); i++)
+	{
+		Snapshot.MaxGaitSpeeds.MaxSpeeds.Add(GetTag(GaitTags[i]), GaitSpeeds[i]);
+	}
+}
+
+FSimpleAnimRecorder& FSimpleAnimRecorder::Get()
+{
+	static FSimpleAnimRecorder Recorder;
+	return Recorder;
+}
+
+FString FSimpleAnimRecorder::GetDefaultFilename()
+{
+	return FPaths::ProfilingDir() / TEXT("SimpleAnim") / FString::Printf(TEXT("SimpleAnim_%s.simplerec"),
+		*FDateTime::Now().ToString());
+}
+
+bool FSimpleAnimRecorder::StartRecording(const FString& Filename)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	if (Writer.IsValid())
+	{
+		UE_LOG(LogSimpleAnimRecorder, Warning, TEXT("Already recording to %s"), *CurrentFilename);
+		return false;
+	}
+
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogSimpleAnimRecorder, Error, TEXT("Failed to open %s for recording"), *Filename);
+		return false;
+	}
+
+	CurrentFilename = Filename;
+	Header = FSimpleAnimRecordHeader();
+	Header.FrameSize = sizeof(FSimpleAnimRecordFrame);
+	StreamIds.Reset();
+	TagIndices.Reset();
+	Tags.Reset();
+
+	// Reserve the header, it is rewritten once the frame count and tag table are known
+	Writer->Serialize(&Header, sizeof(Header));
+
+	bRecording = true;
+	UE_LOG(LogSimpleAnimRecorder, Log, TEXT("Recording SimpleAnimInstance inputs to %s"), *CurrentFilename);
+	return true;
+}
+
+void FSimpleAnimRecorder::StopRecording()
+{
+	FScopeLock Lock(&CriticalSection);
+
+	if (!Writer.IsValid())
+	{
+		return;
+	}
+
+	bRecording = false;
+
+	// Write the tag table
+	Header.TagTableOffset = Writer->Tell();
+	Header.NumTags = Tags.Num();
+	for (const FGameplayTag& Tag : Tags)
+	{
+		const FTCHARToUTF8 TagName(*Tag.ToString());
+		uint16 Length = static_cast<uint16>(TagName.Length());
+		Writer->Serialize(&Length, sizeof(Length));
+		Writer->Serialize(const_cast<ANSICHAR*>(TagName.Get()), Length);
+	}
+
+	// Rewrite the header
+	Header.NumStreams = StreamIds.Num();
+	Writer->Seek(0);
+	Writer->Serialize(&Header, sizeof(Header));
+	Writer->Close();
+	Writer.Reset();
+
+	UE_LOG(LogSimpleAnimRecorder, Log, TEXT("Recorded %llu frames across %u streams to %s"),
+		Header.NumFrames, Header.NumStreams, *CurrentFilename);
+}
+
+uint16 FSimpleAnimRecorder::GetTagIndex(const FGameplayTag& Tag)
+{
+	if (!Tag.IsValid())
+	{
+		return SimpleAnimRecord::InvalidTag;
+	}
+	if (const uint16* Index = TagIndices.Find(Tag))
+	{
+		return *Index;
+	}
+	const uint16 Index = static_cast<uint16>(Tags.Add(Tag));
+	TagIndices.Add(Tag, Index);
+	return Index;
+}
+
+void FSimpleAnimRecorder::Record(const UObject* Instance, const FSimpleLocomotionSnapshot& Snapshot, float DeltaTime)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	if (!Writer.IsValid() || !Instance)
+	{
+		return;
+	}
+
+	const uint16 StreamId = StreamIds.FindOrAdd(Instance, static_cast<uint16>(StreamIds.Num()));
+
+	FSimpleAnimRecordFrame Frame = FSimpleAnimRecordFrame::FromSnapshot(StreamId, Snapshot, DeltaTime,
+		[this](const FGameplayTag& Tag) { return GetTagIndex(Tag); });
+
+	Writer->Serialize(&Frame, sizeof(Frame));
+	Header.NumFrames++;
+}
+
+FSimpleAnimRecording::FSimpleAnimRecording() = default;
+FSimpleAnimRecording::~FSimpleAnimRecording() = default;
+
+bool FSimpleAnimRecording::Open(const FString& Filename, FString& OutError)
+{
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	Header = nullptr;
+	Tags.Reset();
+	Streams.Reset();
+
+	MappedHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (!MappedHandle.IsValid())
+	{
+		OutError = FString::Printf(TEXT("Failed to map %s"), *Filename);
+		return false;
+	}
+
+	const int64 FileSize = MappedHandle->GetFileSize();
+	if (FileSize < static_cast<int64>(sizeof(FSimpleAnimRecordHeader)))
+	{
+		OutError = FString::Printf(TEXT("%s is too small to be a recording"), *Filename);
+		return false;
+	}
+
+	MappedRegion.Reset(MappedHandle->MapRegion(0, FileSize));
+	if (!MappedRegion.IsValid())
+	{
+		OutError = FString::Printf(TEXT("Failed to map region for %s"), *Filename);
+		return false;
+	}
+
+	const uint8* Data = MappedRegion->GetMappedPtr();
+	Header = reinterpret_cast<const FSimpleAnimRecordHeader*>(Data);
+
+	if (Header->Magic != SimpleAnimRecord::Magic || Header->Version != SimpleAnimRecord::Version ||
+		Header->FrameSize != sizeof(FSimpleAnimRecordFrame))
+	{
+		OutError = FString::Printf(TEXT("%s is not a compatible recording (version %u)"), *Filename, Header->Version);
+		return false;
+	}
+
+	const uint64 FramesEnd = sizeof(FSimpleAnimRecordHeader) + Header->NumFrames * sizeof(FSimpleAnimRecordFrame);
+	if (FramesEnd > Header->TagTableOffset || Header->TagTableOffset > static_cast<uint64>(FileSize))
+	{
+		OutError = FString::Printf(TEXT("%s is truncated, was the recording stopped?"), *Filename);
+		return false;
+	}
+
+	// Read the tag table
+	const uint8* TagData = Data + Header->TagTableOffset;
+	const uint8* DataEnd = Data + FileSize;
+	Tags.Reserve(Header->NumTags);
+	for (uint32 i = 0; i < Header->NumTags; i++)
+	{
+		uint16 Length = 0;
+		if (TagData + sizeof(Length) > DataEnd)
+		{
+			break;
+		}
+		FMemory::Memcpy(&Length, TagData, sizeof(Length));
+		TagData += sizeof(Length);
+		if (TagData + Length > DataEnd)
+		{
+			break;
+		}
+		const FUTF8ToTCHAR TagName(reinterpret_cast<const ANSICHAR*>(TagData), Length);
+		Tags.Add(FGameplayTag::RequestGameplayTag(FName(TagName.Length(), TagName.Get()), false));
+		TagData += Length;
+	}
+
+	// Split the frames into their streams, frames are referenced in place
+	const FSimpleAnimRecordFrame* Frames = reinterpret_cast<const FSimpleAnimRecordFrame*>(Data + sizeof(FSimpleAnimRecordHeader));
+	Streams.SetNum(Header->NumStreams);
+	for (uint64 i = 0; i < Header->NumFrames; i++)
+	{
+		const FSimpleAnimRecordFrame& Frame = Frames[i];
+		if (Streams.IsValidIndex(Frame.StreamId))
+		{
+			Streams[Frame.StreamId].Add(&Frame);
+		}
+	}
+
+	return true;
+}
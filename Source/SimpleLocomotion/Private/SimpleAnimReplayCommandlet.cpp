@@ -0,0 +1,199 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "SimpleAnimReplayCommandlet.h"
+
+#include "SimpleAnimInstance.h"
+#include "SimpleAnimRecorder.h"
+#include "SimpleTypes.h"
+#include "Async/ParallelFor.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(SimpleAnimReplayCommandlet)
+
+DEFINE_LOG_CATEGORY_STATIC(LogSimpleAnimReplay, Log, All);
+
+namespace SimpleAnimReplay
+{
+	/** Per-frame output of the first replica of each stream, used to diff results between builds */
+	struct FOutputFrame
+	{
+		uint16 StreamId = 0;
+		uint16 Gait = SimpleAnimRecord::InvalidTag;
+		uint16 Stance = SimpleAnimRecord::InvalidTag;
+		uint16 Flags = 0;
+		float Speed = 0.f;
+		float LeanAngle = 0.f;
+		float StartLeanAngle = 0.f;
+		float CardinalVelocity = 0.f;
+		float CardinalAcceleration = 0.f;
+	};
+
+	enum EOutputFlags : uint16
+	{
+		Output_HasVelocity		= 1 << 0,
+		Output_HasAcceleration	= 1 << 1,
+		Output_InAir			= 1 << 2,
+	};
+}
+
+USimpleAnimReplayCommandlet::USimpleAnimReplayCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 USimpleAnimReplayCommandlet::Main(const FString& Params)
+{
+	using namespace SimpleAnimReplay;
+
+	FString Filename;
+	if (!FParse::Value(*Params, TEXT("file="), Filename))
+	{
+		UE_LOG(LogSimpleAnimReplay, Error, TEXT("Usage: -run=SimpleAnimReplay -file=<Recording> [-instances=N] [-class=<AnimClass>] [-output=<File>]"));
+		return 1;
+	}
+
+	int32 NumInstances = 1;
+	FParse::Value(*Params, TEXT("instances="), NumInstances);
+	NumInstances = FMath::Max(1, NumInstances);
+
+	UClass* AnimClass = USimpleAnimInstance::StaticClass();
+	FString ClassPath;
+	if (FParse::Value(*Params, TEXT("class="), ClassPath))
+	{
+		UClass* LoadedClass = LoadObject<UClass>(nullptr, *ClassPath);
+		if (!LoadedClass || !LoadedClass->IsChildOf(USimpleAnimInstance::StaticClass()))
+		{
+			UE_LOG(LogSimpleAnimReplay, Error, TEXT("%s is not a USimpleAnimInstance class"), *ClassPath);
+			return 1;
+		}
+		AnimClass = LoadedClass;
+	}
+
+	FString OutputFilename;
+	FParse::Value(*Params, TEXT("output="), OutputFilename);
+
+	FSimpleAnimRecording Recording;
+	FString Error;
+	if (!Recording.Open(Filename, Error))
+	{
+		UE_LOG(LogSimpleAnimReplay, Error, TEXT("%s"), *Error);
+		return 1;
+	}
+
+	const TArray<TArray<const FSimpleAnimRecordFrame*>>& Streams = Recording.GetStreams();
+	const TConstArrayView<FGameplayTag> Tags = Recording.GetTags();
+
+	// Each instance replays a single stream, replicated NumInstances times
+	USkeletalMeshComponent* Outer = NewObject<USkeletalMeshComponent>(GetTransientPackage());
+	Outer->AddToRoot();
+
+	TArray<USimpleAnimInstance*> Instances;
+	TArray<int32> InstanceStreams;
+	Instances.Reserve(Streams.Num() * NumInstances);
+	InstanceStreams.Reserve(Streams.Num() * NumInstances);
+	for (int32 StreamId = 0; StreamId < Streams.Num(); StreamId++)
+	{
+		for (int32 i = 0; i < NumInstances; i++)
+		{
+			USimpleAnimInstance* Instance = NewObject<USimpleAnimInstance>(Outer, AnimClass);
+			Instance->InitializeForReplay();
+			Instances.Add(Instance);
+			InstanceStreams.Add(StreamId);
+		}
+	}
+
+	int32 NumSteps = 0;
+	for (const TArray<const FSimpleAnimRecordFrame*>& Stream : Streams)
+	{
+		NumSteps = FMath::Max(NumSteps, Stream.Num());
+	}
+
+	// Output is written by the first replica of each stream only
+	TArray<TArray<FOutputFrame>> Outputs;
+	Outputs.SetNum(Streams.Num());
+
+	auto GetTagIndex = [&Tags](const FGameplayTag& Tag) -> uint16
+	{
+		const int32 Index = Tags.IndexOfByKey(Tag);
+		return Index != INDEX_NONE ? static_cast<uint16>(Index) : SimpleAnimRecord::InvalidTag;
+	};
+
+	const double StartTime = FPlatformTime::Seconds();
+	uint64 NumUpdates = 0;
+
+	for (int32 Step = 0; Step < NumSteps; Step++)
+	{
+		ParallelFor(Instances.Num(), [&](int32 Index)
+		{
+			const int32 StreamId = InstanceStreams[Index];
+			const TArray<const FSimpleAnimRecordFrame*>& Stream = Streams[StreamId];
+			if (!Stream.IsValidIndex(Step))
+			{
+				return;
+			}
+
+			const FSimpleAnimRecordFrame& Frame = *Stream[Step];
+
+			FSimpleLocomotionSnapshot Snapshot;
+			Frame.ToSnapshot(Snapshot, Tags);
+
+			USimpleAnimInstance* Instance = Instances[Index];
+			Instance->ApplySnapshot(Snapshot);
+			Instance->NativeThreadSafeUpdateAnimation(Frame.DeltaTime);
+
+			if (Index % NumInstances == 0)
+			{
+				FOutputFrame& Output = Outputs[StreamId].AddDefaulted_GetRef();
+				Output.StreamId = static_cast<uint16>(StreamId);
+				Output.Gait = GetTagIndex(Instance->Gait);
+				Output.Stance = GetTagIndex(Instance->Stance);
+				Output.Flags |= Instance->bHasVelocity ? Output_HasVelocity : 0;
+				Output.Flags |= Instance->bHasAcceleration ? Output_HasAcceleration : 0;
+				Output.Flags |= Instance->bInAir ? Output_InAir : 0;
+				Output.Speed = Instance->Speed;
+				Output.LeanAngle = Instance->LeanAngle;
+				Output.StartLeanAngle = Instance->StartLeanAngle;
+				Output.CardinalVelocity = Instance->Cardinals.Velocity;
+				Output.CardinalAcceleration = Instance->Cardinals.Acceleration;
+			}
+		});
+
+		for (int32 StreamId = 0; StreamId < Streams.Num(); StreamId++)
+		{
+			NumUpdates += Streams[StreamId].IsValidIndex(Step) ? NumInstances : 0;
+		}
+	}
+
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogSimpleAnimReplay, Display, TEXT("Replayed %d streams x %d instances, %llu updates in %.3fms (%.3fus per update, %.0f updates/s)"),
+		Streams.Num(), NumInstances, NumUpdates, Elapsed * 1000.0,
+		NumUpdates > 0 ? (Elapsed * 1000000.0) / NumUpdates : 0.0,
+		Elapsed > 0.0 ? NumUpdates / Elapsed : 0.0);
+
+	if (!OutputFilename.IsEmpty())
+	{
+		if (TUniquePtr<FArchive> Writer = TUniquePtr<FArchive>(IFileManager::Get().CreateFileWriter(*OutputFilename)))
+		{
+			for (TArray<FOutputFrame>& Output : Outputs)
+			{
+				Writer->Serialize(Output.GetData(), Output.Num() * sizeof(FOutputFrame));
+			}
+			Writer->Close();
+			UE_LOG(LogSimpleAnimReplay, Display, TEXT("Wrote replay output to %s"), *OutputFilename);
+		}
+		else
+		{
+			UE_LOG(LogSimpleAnimReplay, Error, TEXT("Failed to open %s for writing"), *OutputFilename);
+		}
+	}
+
+	Outer->RemoveFromRoot();
+	return 0;
+}
@@ -0,0 +1,131 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "SimpleBakedRootMotion.h"
+
+#include "Algo/BinarySearch.h"
+#include "Animation/AnimSequence.h"
+#include "System/SimpleLocomotionVersioning.h"
+
+#if WITH_EDITOR
+#include "UObject/ObjectSaveContext.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(SimpleBakedRootMotion)
+
+namespace SimpleBakedRootMotion
+{
+	static float SampleAtTime(const TArray<float>& Samples, float SampleInterval, float Time)
+	{
+		const float Sample = FMath::Max(0.f, Time / SampleInterval);
+		const int32 Index = FMath::Min(FMath::FloorToInt32(Sample), Samples.Num() - 1);
+		const int32 NextIndex = FMath::Min(Index + 1, Samples.Num() - 1);
+		return FMath::Lerp(Samples[Index], Samples[NextIndex], Sample - Index);
+	}
+}
+
+float FSimpleBakedRootMotion::GetTimeAtDistance(float Distance) const
+{
+	if (!IsValid() || Distance <= Distances[0])
+	{
+		return 0.f;
+	}
+
+	// First sample at or beyond Distance, the previous sample is before it
+	const int32 Index = Algo::LowerBound(Distances, Distance);
+	if (Index >= Distances.Num())
+	{
+		return PlayLength;
+	}
+
+	const float Range = Distances[Index] - Distances[Index - 1];
+	const float Alpha = Range > UE_KINDA_SMALL_NUMBER ? (Distance - Distances[Index - 1]) / Range : 0.f;
+	return FMath::Min((Index - 1 + Alpha) * SampleInterval, PlayLength);
+}
+
+float FSimpleBakedRootMotion::GetDistanceAtTime(float Time) const
+{
+	return IsValid() ? SimpleBakedRootMotion::SampleAtTime(Distances, SampleInterval, Time) : 0.f;
+}
+
+float FSimpleBakedRootMotion::GetYawAtTime(float Time) const
+{
+	return IsValid() ? SimpleBakedRootMotion::SampleAtTime(Yaws, SampleInterval, Time) : 0.f;
+}
+
+const FSimpleBakedRootMotion* FSimpleBakedRootMotion::Find(const UAnimSequence* Sequence)
+{
+	if (!Sequence)
+	{
+		return nullptr;
+	}
+
+	// Asset user data is only added or removed in the editor, reading it is safe from worker threads
+	UAnimSequence* MutableSequence = const_cast<UAnimSequence*>(Sequence);
+	const USimpleBakedRootMotionUserData* UserData = MutableSequence->GetAssetUserData<USimpleBakedRootMotionUserData>();
+	return UserData && UserData->Baked.IsValid() ? &UserData->Baked : nullptr;
+}
+
+#if WITH_EDITOR
+void FSimpleBakedRootMotion::Bake(const UAnimSequence* Sequence, float SampleRate)
+{
+	PlayLength = Sequence->GetPlayLength();
+
+	// Spread the samples evenly so the last one lands exactly on PlayLength, lookups assume i * SampleInterval
+	const int32 NumSamples = FMath::Max(2, FMath::CeilToInt32(PlayLength * FMath::Max(1.f, SampleRate)) + 1);
+	SampleInterval = PlayLength / (NumSamples - 1);
+	Distances.Reset(NumSamples);
+	Yaws.Reset(NumSamples);
+
+	FVector PrevTranslation = FVector::ZeroVector;
+	float PrevYaw = 0.f;
+	float Distance = 0.f;
+	float Yaw = 0.f;
+	for (int32 i = 0; i < NumSamples; i++)
+	{
+		const float Time = i * SampleInterval;
+#if UE_5_04_OR_LATER
+		const FTransform RootMotion = Sequence->ExtractRootMotionFromRange(0.0, Time, FAnimExtractContext());
+#else
+		const FTransform RootMotion = Sequence->ExtractRootMotionFromRange(0.f, Time);
+#endif
+
+		const FVector Translation = RootMotion.GetTranslation();
+		const float SampleYaw = RootMotion.GetRotation().Rotator().Yaw;
+		Distance += FVector::Dist(PrevTranslation, Translation);
+		Yaw += FMath::FindDeltaAngleDegrees(PrevYaw, SampleYaw);
+		PrevTranslation = Translation;
+		PrevYaw = SampleYaw;
+
+		Distances.Add(Distance);
+		Yaws.Add(Yaw);
+	}
+}
+
+void USimpleBakedRootMotionUserData::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	// Covers both saving and cooking, so the tables are never stale in a cooked build
+	Bake();
+}
+
+void USimpleBakedRootMotionUserData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Bake();
+}
+
+void USimpleBakedRootMotionUserData::Bake()
+{
+	if (const UAnimSequence* Sequence = Cast<UAnimSequence>(GetOuter()))
+	{
+		Baked.Bake(Sequence, SampleRate);
+	}
+	else
+	{
+		Baked = {};
+	}
+}
+#endif
\ No newline at end of file
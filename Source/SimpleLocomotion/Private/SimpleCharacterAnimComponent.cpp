@@ -0,0 +1,55 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "SimpleCharacterAnimComponent.h"
+
+#include "SimpleTags.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(SimpleCharacterAnimComponent)
+
+void USimpleCharacterAnimComponent::SetUpdatedCharacter()
+{
+	Character = Cast<ACharacter>(GetOwner());
+	CharacterMovement = Character ? Character->GetCharacterMovement() : nullptr;
+	ensureMsgf(Character, TEXT("%s requires an ACharacter owner, %s is not one"), *GetName(), *GetNameSafe(GetOwner()));
+}
+
+void USimpleCharacterAnimComponent::GatherSimpleSnapshot(FSimpleLocomotionSnapshot& Snapshot) const
+{
+	// The final getters dereference Character and CharacterMovement
+	if (!GetSimpleOwnerHasInitialized())
+	{
+		return;
+	}
+	GatherSimpleSnapshotFor(*this, *GetOwner(), Snapshot);
+}
+
+float USimpleCharacterAnimComponent::GetSimpleBrakingFriction() const
+{
+	// Matches UCharacterMovementComponent::CalcVelocity() when not accelerating
+	const float Friction = CharacterMovement->bUseSeparateBrakingFriction ? CharacterMovement->BrakingFriction : CharacterMovement->GroundFriction;
+	return Friction * FMath::Max(0.f, CharacterMovement->BrakingFrictionFactor);
+}
+
+float USimpleCharacterAnimComponent::GetSimpleGroundProbeHalfHeight() const
+{
+	const UCapsuleComponent* Capsule = Character ? Character->GetCapsuleComponent() : nullptr;
+	return Capsule ? Capsule->GetScaledCapsuleHalfHeight() : Super::GetSimpleGroundProbeHalfHeight();
+}
+
+ECollisionChannel USimpleCharacterAnimComponent::GetSimpleGroundProbeChannel() const
+{
+	const USceneComponent* Updated = CharacterMovement ? CharacterMovement->UpdatedComponent.Get() : nullptr;
+	return Updated ? Updated->GetCollisionObjectType() : Super::GetSimpleGroundProbeChannel();
+}
+
+FSimpleGaitSpeed USimpleCharacterAnimComponent::GetSimpleMaxGaitSpeeds() const
+{
+	const float MaxWalkSpeed = CharacterMovement->MaxWalkSpeed;
+	
+	TMap<FGameplayTag, float> MaxSpeeds;
+	MaxSpeeds.Add(FSimpleTags::Simple_Gait_Walk, MaxWalkSpeed);
+	MaxSpeeds.Add(FSimpleTags::Simple_Gait_Run, MaxWalkSpeed);
+	MaxSpeeds.Add(FSimpleTags::Simple_Gait_Sprint, MaxWalkSpeed);
+	return FSimpleGaitSpeed { MaxSpeeds };
+}
\ No newline at end of file
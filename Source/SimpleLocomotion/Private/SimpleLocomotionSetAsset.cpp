@@ -0,0 +1,163 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "SimpleLocomotionSetAsset.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(SimpleLocomotionSetAsset)
+
+const FPrimaryAssetType USimpleLocomotionSetAsset::PrimaryAssetType = TEXT("SimpleLocomotionSet");
+
+FPrimaryAssetId USimpleLocomotionSetAsset::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+void USimpleLocomotionSetAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	Compile();
+}
+
+#if WITH_EDITOR
+void USimpleLocomotionSetAsset::PreEditChange(FProperty* PropertyAboutToChange)
+{
+	Super::PreEditChange(PropertyAboutToChange);
+
+	// The tables point into the sets about to change, nothing resolves until PostEditChangeProperty() recompiles
+	FWriteScopeLock WriteLock(CompiledLock);
+	CompileSerial++;
+	CompiledStrafe.Reset();
+	CompiledStart.Reset();
+	CompiledTurn.Reset();
+}
+
+void USimpleLocomotionSetAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Compile();
+}
+#endif
+
+void USimpleLocomotionSetAsset::Compile()
+{
+	check(IsInGameThread());
+
+	// Build outside the lock so readers only wait for the swap
+	TSimpleCompiledSetTable<FSimpleStrafeLocoSet> NewStrafe;
+	TSimpleCompiledSetTable<FSimpleStartLocoSet> NewStart;
+	TSimpleCompiledSetTable<FSimpleTurnLocoSet> NewTurn;
+	NewStrafe.Compile<FSimpleStanceToStrafeGaitSet, FSimpleStrafeGaitSet>(StrafeSets);
+	NewStart.Compile<FSimpleStanceToStartGaitSet, FSimpleStartGaitSet>(StartSets);
+	NewTurn.Compile<FSimpleStanceToTurnGaitSet, FSimpleTurnGaitSet>(TurnSets);
+
+	FWriteScopeLock WriteLock(CompiledLock);
+	CompileSerial++;
+	CompiledStrafe = MoveTemp(NewStrafe);
+	CompiledStart = MoveTemp(NewStart);
+	CompiledTurn = MoveTemp(NewTurn);
+}
+
+FSimpleLocoSetHandle USimpleLocomotionSetAsset::GetSetHandle(ESimpleLocoSetType Type, FGameplayTag State, FGameplayTag Stance,
+	FGameplayTag Gait) const
+{
+	FReadScopeLock ReadLock(CompiledLock);
+
+	FSimpleLocoSetHandle Handle;
+	switch (Type)
+	{
+	case ESimpleLocoSetType::Strafe: Handle.Index = CompiledStrafe.Find(State, Stance, Gait); break;
+	case ESimpleLocoSetType::Start: Handle.Index = CompiledStart.Find(State, Stance, Gait); break;
+	case ESimpleLocoSetType::Turn: Handle.Index = CompiledTurn.Find(State, Stance, Gait); break;
+	}
+
+	if (Handle.Index != INDEX_NONE)
+	{
+		Handle.Asset = const_cast<USimpleLocomotionSetAsset*>(this);
+		Handle.Serial = CompileSerial.load(std::memory_order_relaxed);
+		Handle.Type = Type;
+	}
+	return Handle;
+}
+
+UAnimSequence* USimpleLocomotionSetAsset::GetAnimation(const FSimpleLocoSetHandle& Handle, const FGameplayTag& CardinalTag) const
+{
+	// Resolve while locked, the set points into the authored maps
+	FReadScopeLock ReadLock(CompiledLock);
+
+	switch (Handle.Type)
+	{
+	case ESimpleLocoSetType::Strafe:
+		{
+			const FSimpleStrafeLocoSet* LocoSet = GetStrafeSet(Handle);
+			return LocoSet ? LocoSet->GetAnimation(CardinalTag) : nullptr;
+		}
+	case ESimpleLocoSetType::Start:
+		{
+			const FSimpleStartLocoSet* LocoSet = GetStartSet(Handle);
+			return LocoSet ? LocoSet->GetAnimation(CardinalTag) : nullptr;
+		}
+	case ESimpleLocoSetType::Turn:
+		{
+			const FSimpleTurnLocoSet* LocoSet = GetTurnSet(Handle);
+			return LocoSet ? LocoSet->GetAnimation(CardinalTag) : nullptr;
+		}
+	}
+	return nullptr;
+}
+
+bool USimpleLocomotionSetAsset::GetAnimations(const FSimpleLocoSetHandle& Handle, FSimpleLocoSetAnimations& OutAnimations) const
+{
+	FReadScopeLock ReadLock(CompiledLock);
+
+	switch (Handle.Type)
+	{
+	case ESimpleLocoSetType::Strafe:
+		if (const FSimpleStrafeLocoSet* LocoSet = GetStrafeSet(Handle))
+		{
+			OutAnimations.Resolve(*LocoSet);
+			return true;
+		}
+		break;
+	case ESimpleLocoSetType::Start:
+		if (const FSimpleStartLocoSet* LocoSet = GetStartSet(Handle))
+		{
+			OutAnimations.Resolve(*LocoSet);
+			return true;
+		}
+		break;
+	case ESimpleLocoSetType::Turn:
+		if (const FSimpleTurnLocoSet* LocoSet = GetTurnSet(Handle))
+		{
+			OutAnimations.Resolve(*LocoSet);
+			return true;
+		}
+		break;
+	}
+	return false;
+}
+
+UAnimSequence* USimpleLocomotionSetAsset::GetStrafeAnimation(FGameplayTag State, FGameplayTag Stance, FGameplayTag Gait,
+	FGameplayTag Cardinal) const
+{
+	FReadScopeLock ReadLock(CompiledLock);
+	const FSimpleStrafeLocoSet* LocoSet = FindStrafeSet(State, Stance, Gait);
+	return LocoSet ? LocoSet->GetAnimation(Cardinal) : nullptr;
+}
+
+UAnimSequence* USimpleLocomotionSetAsset::GetStartAnimation(FGameplayTag State, FGameplayTag Stance, FGameplayTag Gait,
+	FGameplayTag Cardinal) const
+{
+	FReadScopeLock ReadLock(CompiledLock);
+	const FSimpleStartLocoSet* LocoSet = FindStartSet(State, Stance, Gait);
+	return LocoSet ? LocoSet->GetAnimation(Cardinal) : nullptr;
+}
+
+UAnimSequence* USimpleLocomotionSetAsset::GetTurnAnimation(FGameplayTag State, FGameplayTag Stance, FGameplayTag Gait,
+	FGameplayTag Cardinal) const
+{
+	FReadScopeLock ReadLock(CompiledLock);
+	const FSimpleTurnLocoSet* LocoSet = FindTurnSet(State, Stance, Gait);
+	return LocoSet ? LocoSet->GetAnimation(Cardinal) : nullptr;
+}
\ No newline at end of file
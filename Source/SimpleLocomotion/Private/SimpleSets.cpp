@@ -3,11 +3,134 @@
 
 #include "SimpleSets.h"
 
+#include "Animation/AnimSequence.h"
+#include "SimpleBakedRootMotion.h"
+#include "SimpleLocomotionSetAsset.h"
 #include "SimpleTags.h"
 #include "SimpleTypes.h"
+#include "System/SimpleLocomotionVersioning.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(SimpleSets)
 
+const TMap<FGameplayTag, FSimpleGameplayTagArray>& FSimpleGetter::GetDefaultFallbacks()
+{
+	// Gait and stance tags never collide, so one table serves both and never matches a state
+	static const TMap<FGameplayTag, FSimpleGameplayTagArray> DefaultFallbacks = []
+	{
+		TMap<FGameplayTag, FSimpleGameplayTagArray> Fallbacks;
+		Fallbacks.Reserve(6);
+
+		// Strolling should fall back to walk if unavailable, otherwise run, otherwise sprint
+		FSimpleGameplayTagArray& StrollFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Stroll);
+		StrollFallback.AddTagFast(FSimpleTags::Simple_Gait_Walk);
+		StrollFallback.AddTagFast(FSimpleTags::Simple_Gait_Run);
+		StrollFallback.AddTagFast(FSimpleTags::Simple_Gait_Sprint);
+
+		// Walking should fall back to run if unavailable, otherwise stroll, otherwise sprint
+		FSimpleGameplayTagArray& WalkFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Walk);
+		WalkFallback.AddTagFast(FSimpleTags::Simple_Gait_Run);
+		WalkFallback.AddTagFast(FSimpleTags::Simple_Gait_Stroll);
+		WalkFallback.AddTagFast(FSimpleTags::Simple_Gait_Sprint);
+
+		// Run should fall back to walk if unavailable, otherwise sprint, otherwise stroll
+		FSimpleGameplayTagArray& RunFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Run);
+		RunFallback.AddTagFast(FSimpleTags::Simple_Gait_Walk);
+		RunFallback.AddTagFast(FSimpleTags::Simple_Gait_Sprint);
+		RunFallback.AddTagFast(FSimpleTags::Simple_Gait_Stroll);
+
+		// Sprint should fall back to run if unavailable, otherwise walk, otherwise stroll
+		FSimpleGameplayTagArray& SprintFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Sprint);
+		SprintFallback.AddTagFast(FSimpleTags::Simple_Gait_Run);
+		SprintFallback.AddTagFast(FSimpleTags::Simple_Gait_Walk);
+		SprintFallback.AddTagFast(FSimpleTags::Simple_Gait_Stroll);
+
+		// Crouch falls back to standing
+		FSimpleGameplayTagArray& CrouchFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Crouch);
+		CrouchFallback.AddTagFast(FSimpleTags::Simple_Stance_Stand);
+
+		// Prone falls back to crouch
+		FSimpleGameplayTagArray& ProneFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Prone);
+		ProneFallback.AddTagFast(FSimpleTags::Simple_Stance_Crouch);
+
+		return Fallbacks;
+	}();
+	return DefaultFallbacks;
+}
+
+namespace SimpleLocoSetAnimations
+{
+	template<typename T>
+	static void ResolveAnimations(FSimpleLocoSetAnimations& Out, const T& LocoSet)
+	{
+		Out.Mode = LocoSet.Mode;
+		Out.Num = 0;
+
+		// The default cardinal table already knows which cardinals each mode uses
+		const FSimpleCardinal* Cardinal = FSimpleCardinals::GetDefaultCardinals().Find(LocoSet.Mode);
+		if (!Cardinal)
+		{
+			return;
+		}
+
+		for (const FGameplayTag& CardinalTag : Cardinal->Tags)
+		{
+			if (Out.Num == FSimpleLocoSetAnimations::MaxCardinals)
+			{
+				break;
+			}
+			Out.Cardinals[Out.Num] = CardinalTag;
+			Out.Animations[Out.Num] = LocoSet.GetAnimation(CardinalTag);
+			Out.Num++;
+		}
+	}
+}
+
+FSimpleLocoSetPrefetch FSimpleLocoSetAnimations::PrefetchOverride;
+
+void FSimpleLocoSetAnimations::Resolve(const FSimpleStrafeLocoSet& LocoSet)
+{
+	SimpleLocoSetAnimations::ResolveAnimations(*this, LocoSet);
+}
+
+void FSimpleLocoSetAnimations::Resolve(const FSimpleStartLocoSet& LocoSet)
+{
+	SimpleLocoSetAnimations::ResolveAnimations(*this, LocoSet);
+}
+
+void FSimpleLocoSetAnimations::Resolve(const FSimpleTurnLocoSet& LocoSet)
+{
+	SimpleLocoSetAnimations::ResolveAnimations(*this, LocoSet);
+}
+
+void FSimpleLocoSetAnimations::Prefetch() const
+{
+	if (PrefetchOverride.IsBound())
+	{
+		PrefetchOverride.Execute(*this);
+		return;
+	}
+
+	for (int32 i = 0; i < Num; i++)
+	{
+		// Each animation may be used by more than one cardinal
+		const UAnimSequence* Sequence = Animations[i];
+		bool bDuplicate = false;
+		for (int32 j = 0; j < i && !bDuplicate; j++)
+		{
+			bDuplicate = Animations[j] == Sequence;
+		}
+
+		if (Sequence && !bDuplicate)
+		{
+			// Decompressing the root track touches the compressed data and codec ahead of the first pose evaluation
+#if UE_5_04_OR_LATER
+			Sequence->ExtractRootMotionFromRange(0.0, Sequence->GetPlayLength(), FAnimExtractContext());
+#else
+			Sequence->ExtractRootMotionFromRange(0.f, Sequence->GetPlayLength());
+#endif
+		}
+	}
+}
 
 FSimpleStrafeLocoSet::FSimpleStrafeLocoSet()
 	: Mode(FSimpleTags::Simple_Mode_Strafe_4Way)
@@ -96,6 +219,11 @@ UAnimSequence* FSimpleStartLocoSet::GetAnimation(const FGameplayTag& CardinalTag
 	return nullptr;
 }
 
+const FSimpleBakedRootMotion* FSimpleStartLocoSet::GetBakedRootMotion(const FGameplayTag& CardinalTag) const
+{
+	return FSimpleBakedRootMotion::Find(GetAnimation(CardinalTag));
+}
+
 FSimpleTurnLocoSet::FSimpleTurnLocoSet()
 	: Mode(FSimpleTags::Simple_Mode_Turn_1Way)
 	, AngleTolerance(30.f)
@@ -124,33 +252,14 @@ UAnimSequence* FSimpleTurnLocoSet::GetAnimation(const FGameplayTag& CardinalTag)
 	return nullptr;
 }
 
+const FSimpleBakedRootMotion* FSimpleTurnLocoSet::GetBakedRootMotion(const FGameplayTag& CardinalTag) const
+{
+	return FSimpleBakedRootMotion::Find(GetAnimation(CardinalTag));
+}
+
 FSimpleStrafeGaitSet::FSimpleStrafeGaitSet()
 {
 	GaitSets.Add(FSimpleTags::Simple_Gait_Run);
-
-	// Strolling should fall back to walk if unavailable, otherwise run, otherwise sprint
-	FSimpleGameplayTagArray& StrollFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Stroll);
-	StrollFallback.AddTagFast(FSimpleTags::Simple_Gait_Walk);
-	StrollFallback.AddTagFast(FSimpleTags::Simple_Gait_Run);
-	StrollFallback.AddTagFast(FSimpleTags::Simple_Gait_Sprint);
-
-	// Walking should fall back to run if unavailable, otherwise stroll, otherwise sprint
-	FSimpleGameplayTagArray& WalkFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Walk);
-	WalkFallback.AddTagFast(FSimpleTags::Simple_Gait_Run);
-	WalkFallback.AddTagFast(FSimpleTags::Simple_Gait_Stroll);
-	WalkFallback.AddTagFast(FSimpleTags::Simple_Gait_Sprint);
-
-	// Run should fall back to walk if unavailable, otherwise sprint, otherwise stroll
-	FSimpleGameplayTagArray& RunFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Run);
-	RunFallback.AddTagFast(FSimpleTags::Simple_Gait_Walk);
-	RunFallback.AddTagFast(FSimpleTags::Simple_Gait_Sprint);
-	RunFallback.AddTagFast(FSimpleTags::Simple_Gait_Stroll);
-	
-	// Sprint should fall back to run if unavailable, otherwise walk, otherwise stroll
-	FSimpleGameplayTagArray& SprintFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Sprint);
-	SprintFallback.AddTagFast(FSimpleTags::Simple_Gait_Run);
-	SprintFallback.AddTagFast(FSimpleTags::Simple_Gait_Walk);
-	SprintFallback.AddTagFast(FSimpleTags::Simple_Gait_Stroll);
 }
 
 void FSimpleStrafeGaitSet::SetCardinalType(ESimpleCardinalType CardinalType)
@@ -165,30 +274,6 @@ void FSimpleStrafeGaitSet::SetCardinalType(ESimpleCardinalType CardinalType)
 FSimpleStartGaitSet::FSimpleStartGaitSet()
 {
 	GaitSets.Add(FSimpleTags::Simple_Gait_Run);
-
-	// Strolling should fall back to walk if unavailable, otherwise run, otherwise sprint
-	FSimpleGameplayTagArray& StrollFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Stroll);
-	StrollFallback.AddTagFast(FSimpleTags::Simple_Gait_Walk);
-	StrollFallback.AddTagFast(FSimpleTags::Simple_Gait_Run);
-	StrollFallback.AddTagFast(FSimpleTags::Simple_Gait_Sprint);
-
-	// Walking should fall back to run if unavailable, otherwise stroll, otherwise sprint
-	FSimpleGameplayTagArray& WalkFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Walk);
-	WalkFallback.AddTagFast(FSimpleTags::Simple_Gait_Run);
-	WalkFallback.AddTagFast(FSimpleTags::Simple_Gait_Stroll);
-	WalkFallback.AddTagFast(FSimpleTags::Simple_Gait_Sprint);
-
-	// Run should fall back to walk if unavailable, otherwise sprint, otherwise stroll
-	FSimpleGameplayTagArray& RunFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Run);
-	RunFallback.AddTagFast(FSimpleTags::Simple_Gait_Walk);
-	RunFallback.AddTagFast(FSimpleTags::Simple_Gait_Sprint);
-	RunFallback.AddTagFast(FSimpleTags::Simple_Gait_Stroll);
-	
-	// Sprint should fall back to run if unavailable, otherwise walk, otherwise stroll
-	FSimpleGameplayTagArray& SprintFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Sprint);
-	SprintFallback.AddTagFast(FSimpleTags::Simple_Gait_Run);
-	SprintFallback.AddTagFast(FSimpleTags::Simple_Gait_Walk);
-	SprintFallback.AddTagFast(FSimpleTags::Simple_Gait_Stroll);
 }
 
 void FSimpleStartGaitSet::SetCardinalType(ESimpleCardinalType CardinalType)
@@ -203,30 +288,6 @@ void FSimpleStartGaitSet::SetCardinalType(ESimpleCardinalType CardinalType)
 FSimpleTurnGaitSet::FSimpleTurnGaitSet()
 {
 	GaitSets.Add(FSimpleTags::Simple_Gait_Run);
-
-	// Strolling should fall back to walk if unavailable, otherwise run, otherwise sprint
-	FSimpleGameplayTagArray& StrollFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Stroll);
-	StrollFallback.AddTagFast(FSimpleTags::Simple_Gait_Walk);
-	StrollFallback.AddTagFast(FSimpleTags::Simple_Gait_Run);
-	StrollFallback.AddTagFast(FSimpleTags::Simple_Gait_Sprint);
-
-	// Walking should fall back to run if unavailable, otherwise stroll, otherwise sprint
-	FSimpleGameplayTagArray& WalkFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Walk);
-	WalkFallback.AddTagFast(FSimpleTags::Simple_Gait_Run);
-	WalkFallback.AddTagFast(FSimpleTags::Simple_Gait_Stroll);
-	WalkFallback.AddTagFast(FSimpleTags::Simple_Gait_Sprint);
-
-	// Run should fall back to walk if unavailable, otherwise sprint, otherwise stroll
-	FSimpleGameplayTagArray& RunFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Run);
-	RunFallback.AddTagFast(FSimpleTags::Simple_Gait_Walk);
-	RunFallback.AddTagFast(FSimpleTags::Simple_Gait_Sprint);
-	RunFallback.AddTagFast(FSimpleTags::Simple_Gait_Stroll);
-	
-	// Sprint should fall back to run if unavailable, otherwise walk, otherwise stroll
-	FSimpleGameplayTagArray& SprintFallback = Fallbacks.Add(FSimpleTags::Simple_Gait_Sprint);
-	SprintFallback.AddTagFast(FSimpleTags::Simple_Gait_Run);
-	SprintFallback.AddTagFast(FSimpleTags::Simple_Gait_Walk);
-	SprintFallback.AddTagFast(FSimpleTags::Simple_Gait_Stroll);
 }
 
 void FSimpleTurnGaitSet::SetCardinalType(ESimpleCardinalType CardinalType)
@@ -241,66 +302,26 @@ void FSimpleTurnGaitSet::SetCardinalType(ESimpleCardinalType CardinalType)
 FSimpleStanceSet::FSimpleStanceSet()
 {
 	Animations.Add(FSimpleTags::Simple_Stance_Stand);
-	
-	// Crouch falls back to standing
-	FSimpleGameplayTagArray& CrouchFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Crouch);
-	CrouchFallback.AddTagFast(FSimpleTags::Simple_Stance_Stand);
-
-	// Prone falls back to crouch
-	FSimpleGameplayTagArray& ProneFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Prone);
-	ProneFallback.AddTagFast(FSimpleTags::Simple_Stance_Crouch);
 }
 
 FSimpleStanceToStrafeLocoSet::FSimpleStanceToStrafeLocoSet()
 {
 	StanceSets.Add(FSimpleTags::Simple_Stance_Stand);
-
-	// Crouch falls back to standing
-	FSimpleGameplayTagArray& CrouchFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Crouch);
-	CrouchFallback.AddTagFast(FSimpleTags::Simple_Stance_Stand);
-
-	// Prone falls back to crouch
-	FSimpleGameplayTagArray& ProneFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Prone);
-	ProneFallback.AddTagFast(FSimpleTags::Simple_Stance_Crouch);
 }
 
 FSimpleStanceToStrafeGaitSet::FSimpleStanceToStrafeGaitSet()
 {
 	StanceSets.Add(FSimpleTags::Simple_Stance_Stand);
-
-	// Crouch falls back to standing
-	FSimpleGameplayTagArray& CrouchFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Crouch);
-	CrouchFallback.AddTagFast(FSimpleTags::Simple_Stance_Stand);
-
-	// Prone falls back to crouch
-	FSimpleGameplayTagArray& ProneFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Prone);
-	ProneFallback.AddTagFast(FSimpleTags::Simple_Stance_Crouch);
 }
 
 FSimpleStanceToStartGaitSet::FSimpleStanceToStartGaitSet()
 {
 	StanceSets.Add(FSimpleTags::Simple_Stance_Stand);
-
-	// Crouch falls back to standing
-	FSimpleGameplayTagArray& CrouchFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Crouch);
-	CrouchFallback.AddTagFast(FSimpleTags::Simple_Stance_Stand);
-
-	// Prone falls back to crouch
-	FSimpleGameplayTagArray& ProneFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Prone);
-	ProneFallback.AddTagFast(FSimpleTags::Simple_Stance_Crouch);
 }
 
 FSimpleStanceToTurnGaitSet::FSimpleStanceToTurnGaitSet()
 {
 	StanceSets.Add(FSimpleTags::Simple_Stance_Stand);
-
-	// Crouch falls back to standing
-	FSimpleGameplayTagArray& CrouchFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Crouch);
-	CrouchFallback.AddTagFast(FSimpleTags::Simple_Stance_Stand);
-
-	// Prone falls back to crouch
-	FSimpleGameplayTagArray& ProneFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Prone);
-	ProneFallback.AddTagFast(FSimpleTags::Simple_Stance_Crouch);
 }
 
 FSimpleStateToStrafeGaitSet::FSimpleStateToStrafeGaitSet()
@@ -341,14 +362,6 @@ FSimpleStateToStanceToTurnGaitSet::FSimpleStateToStanceToTurnGaitSet()
 FSimpleStanceToTransitionSet::FSimpleStanceToTransitionSet()
 {
 	StanceSets.Add(FSimpleTags::Simple_Stance_Stand);
-	
-	// Crouch falls back to standing
-	FSimpleGameplayTagArray& CrouchFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Crouch);
-	CrouchFallback.AddTagFast(FSimpleTags::Simple_Stance_Stand);
-
-	// Prone falls back to crouch
-	FSimpleGameplayTagArray& ProneFallback = Fallbacks.Add(FSimpleTags::Simple_Stance_Prone);
-	ProneFallback.AddTagFast(FSimpleTags::Simple_Stance_Crouch);
 }
 
 FSimpleStateToStanceSet::FSimpleStateToStanceSet()
@@ -370,3 +383,18 @@ FSimpleStateToStanceToTransitionSet::FSimpleStateToStanceToTransitionSet()
 {
 	StateSets.Add(FSimpleTags::Simple_State_Default);
 }
+
+bool FSimpleLocoSetHandle::IsValid() const
+{
+	return Asset && Index != INDEX_NONE && Serial == Asset->GetCompileSerial();
+}
+
+UAnimSequence* FSimpleLocoSetHandle::GetAnimation(const FGameplayTag& CardinalTag) const
+{
+	return IsValid() ? Asset->GetAnimation(*this, CardinalTag) : nullptr;
+}
+
+bool FSimpleLocoSetHandle::GetAnimations(FSimpleLocoSetAnimations& OutAnimations) const
+{
+	return IsValid() && Asset->GetAnimations(*this, OutAnimations);
+}
\ No newline at end of file
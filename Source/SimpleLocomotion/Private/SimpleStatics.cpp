@@ -3,6 +3,7 @@
 
 #include "SimpleStatics.h"
 
+#include "SimpleBakedRootMotion.h"
 #include "SimpleTags.h"
 #include "SimpleTypes.h"
 
@@ -39,6 +40,17 @@ FGameplayTag USimpleStatics::GetSimpleCardinalForTag(const FSimpleCardinals& Car
 	return Cardinals.GetCurrentCardinal(CardinalMode, CardinalType, bOnWall);
 }
 
+FSimpleCardinal USimpleStatics::GetSimpleCardinalResult(const FSimpleCardinals& Cardinals, FGameplayTag CardinalMode)
+{
+	return Cardinals.GetCurrentResult(CardinalMode);
+}
+
+FSimpleCardinalHistory USimpleStatics::GetSimpleCardinalHistory(const FSimpleCardinals& Cardinals, FGameplayTag CardinalMode,
+	ESimpleCardinalType CardinalType, bool bOnWall)
+{
+	return Cardinals.GetCurrentHistory(CardinalMode, CardinalType, bOnWall);
+}
+
 FGameplayTag USimpleStatics::SelectSimpleCardinalFromAngle(const FGameplayTag& CardinalMode, float Angle, float DeadZone, const FGameplayTag& CurrentDirection, bool bWasMovingLastUpdate)
 {
 	if (CardinalMode == FSimpleTags::Simple_Mode_Strafe_1Way)
@@ -536,6 +548,23 @@ FGameplayTag USimpleStatics::SelectBasicCardinalFromAngle(const FGameplayTag& Ca
 	return FGameplayTag::EmptyTag;
 }
 
+float USimpleStatics::GetSimpleCardinalAngle(const FGameplayTag& CardinalTag)
+{
+	if (CardinalTag == FSimpleTags::Simple_Cardinal_Forward)				{ return 0.f; }
+	if (CardinalTag == FSimpleTags::Simple_Cardinal_Forward_Left)		{ return -45.f; }
+	if (CardinalTag == FSimpleTags::Simple_Cardinal_Forward_Right)		{ return 45.f; }
+	if (CardinalTag == FSimpleTags::Simple_Cardinal_Left)				{ return -90.f; }
+	if (CardinalTag == FSimpleTags::Simple_Cardinal_Right)				{ return 90.f; }
+	if (CardinalTag == FSimpleTags::Simple_Cardinal_Left_Away)			{ return -90.f; }
+	if (CardinalTag == FSimpleTags::Simple_Cardinal_Right_Away)			{ return 90.f; }
+	if (CardinalTag == FSimpleTags::Simple_Cardinal_Backward)			{ return 180.f; }
+	if (CardinalTag == FSimpleTags::Simple_Cardinal_Backward_Left)		{ return -135.f; }
+	if (CardinalTag == FSimpleTags::Simple_Cardinal_Backward_Right)		{ return 135.f; }
+	if (CardinalTag == FSimpleTags::Simple_Cardinal_BackwardTurnLeft)	{ return -180.f; }
+	if (CardinalTag == FSimpleTags::Simple_Cardinal_BackwardTurnRight)	{ return 180.f; }
+	return 0.f;
+}
+
 FGameplayTag USimpleStatics::GetSimpleOppositeCardinal(const FGameplayTag& CardinalTag)
 {
 	if (CardinalTag == FSimpleTags::Simple_Cardinal_Forward) { return FSimpleTags::Simple_Cardinal_Backward; }
@@ -570,6 +599,63 @@ FGameplayTag USimpleStatics::GetDowngradedCardinal(const FGameplayTag& CardinalT
 	return FGameplayTag::EmptyTag;
 }
 
+bool USimpleStatics::PredictSimpleStop(float Speed, float BrakingDeceleration, float BrakingFriction, float& StopDistance,
+	float& StopTime)
+{
+	// UCharacterMovementComponent zeroes velocity below BRAKE_TO_STOP_VELOCITY rather than braking all the way
+	static constexpr float StopSpeed = 10.f;
+
+	StopDistance = 0.f;
+	StopTime = 0.f;
+
+	const float Decel = FMath::Max(0.f, BrakingDeceleration);
+	const float Friction = FMath::Max(0.f, BrakingFriction);
+	if (Speed <= StopSpeed)
+	{
+		return true;
+	}
+
+	if (Friction > UE_KINDA_SMALL_NUMBER)
+	{
+		// dv/dt = -Friction * v - Decel
+		const float DecelRatio = Decel / Friction;
+		StopTime = FMath::Loge((Speed + DecelRatio) / (StopSpeed + DecelRatio)) / Friction;
+		StopDistance = ((Speed - StopSpeed) - Decel * StopTime) / Friction;
+		return true;
+	}
+
+	if (Decel > UE_KINDA_SMALL_NUMBER)
+	{
+		// dv/dt = -Decel
+		StopTime = (Speed - StopSpeed) / Decel;
+		StopDistance = (FMath::Square(Speed) - FMath::Square(StopSpeed)) / (2.f * Decel);
+		return true;
+	}
+
+	return false;
+}
+
+bool USimpleStatics::GetSimpleBakedTimeAtDistance(const UAnimSequence* Sequence, float Distance, float& Time)
+{
+	const FSimpleBakedRootMotion* Baked = FSimpleBakedRootMotion::Find(Sequence);
+	Time = Baked ? Baked->GetTimeAtDistance(Distance) : 0.f;
+	return Baked != nullptr;
+}
+
+bool USimpleStatics::GetSimpleBakedDistanceAtTime(const UAnimSequence* Sequence, float Time, float& Distance)
+{
+	const FSimpleBakedRootMotion* Baked = FSimpleBakedRootMotion::Find(Sequence);
+	Distance = Baked ? Baked->GetDistanceAtTime(Time) : 0.f;
+	return Baked != nullptr;
+}
+
+bool USimpleStatics::GetSimpleBakedYawAtTime(const UAnimSequence* Sequence, float Time, float& Yaw)
+{
+	const FSimpleBakedRootMotion* Baked = FSimpleBakedRootMotion::Find(Sequence);
+	Yaw = Baked ? Baked->GetYawAtTime(Time) : 0.f;
+	return Baked != nullptr;
+}
+
 bool USimpleStatics::IsMovementTurningRight(const FVector& Acceleration, const FVector& Velocity,
 	const FVector& ActorRightVector)
 {
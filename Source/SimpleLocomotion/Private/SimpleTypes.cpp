@@ -5,6 +5,7 @@
 
 #include "SimpleTags.h"
 #include "SimpleSets.h"
+#include "SimpleStatics.h"
 
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(SimpleTypes)
@@ -76,7 +77,7 @@ float FBlendByBoolState::Update(bool bActive, const FBlendByBool& Params, float
 	return Weight;
 }
 
-float FSimpleGaitSpeed::GetMaxSpeed(const FGameplayTag& GaitTag)
+float FSimpleGaitSpeed::GetMaxSpeed(const FGameplayTag& GaitTag) const
 {
 	if (const float* MaxSpeed = MaxSpeeds.Find(GaitTag))
 	{
@@ -91,98 +92,230 @@ float FSimpleGaitSpeed::GetMaxSpeed(const FGameplayTag& GaitTag)
 	return 0.f;
 }
 
-FGameplayTag FSimpleCardinal::GetCardinal(ESimpleCardinalType CardinalType, bool bOnWall) const
+uint32 FSimpleGaitSpeed::GetSpeedsHash() const
 {
-	switch (CardinalType)
+	uint32 Hash = GetTypeHash(MaxSpeeds.Num());
+	for (const TPair<FGameplayTag, float>& Pair : MaxSpeeds)
 	{
-	case ESimpleCardinalType::Acceleration: return bOnWall ? AccelerationWall : Acceleration;
-	case ESimpleCardinalType::Velocity: return bOnWall ? VelocityWall : Velocity;
+		Hash = HashCombineFast(Hash, HashCombineFast(GetTypeHash(Pair.Key), GetTypeHash(Pair.Value)));
 	}
-	return FGameplayTag::EmptyTag;
+	return Hash;
 }
 
-void FSimpleCardinals::ConstructDefaultCardinals(bool bEnableDefaultCardinals)
+void FSimpleGaitClassifier::Update(const FSimpleGaitSpeed& GaitSpeeds)
 {
-	// 1-Way
-	{
-		FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Strafe_1Way);
-		Cardinal.Tags = ConstructCardinalTags_1Way();
-		Cardinal.bEnabled = false;
-	}
-	// 2-Way
+	const uint32 Hash = GaitSpeeds.GetSpeedsHash();
+	if (bBuilt && Hash == SpeedsHash)
 	{
-		FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Strafe_2Way);
-		Cardinal.Tags = ConstructCardinalTags_2Way();
-		Cardinal.bEnabled = false;
+		return;
 	}
-	// 4-Way
-	{
-		FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Strafe_4Way);
-		Cardinal.Tags = ConstructCardinalTags_4Way();
-		Cardinal.bEnabled = bEnableDefaultCardinals;
-	}
-	// 6-Way
+	bBuilt = true;
+	SpeedsHash = Hash;
+
+	// Built-in gaits keep their order regardless of speed
+	const FGameplayTag BuiltInGaits[] = { FSimpleTags::Simple_Gait_Stroll, FSimpleTags::Simple_Gait_Walk,
+		FSimpleTags::Simple_Gait_Run, FSimpleTags::Simple_Gait_Sprint };
+
+	TArray<float, TInlineAllocator<8>> Speeds;
+	Gaits.Reset();
+	for (const FGameplayTag& Gait : BuiltInGaits)
 	{
-		FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Strafe_6Way);
-		Cardinal.Tags = ConstructCardinalTags_6Way();
-		Cardinal.bEnabled = false;
+		Gaits.Add(Gait);
+		Speeds.Add(GaitSpeeds.GetMaxSpeed(Gait));
 	}
-	// 8-Way
+
+	// Project gaits are inserted after the last gait that is not faster
+	for (const TPair<FGameplayTag, float>& Pair : GaitSpeeds.MaxSpeeds)
 	{
-		FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Strafe_8Way);
-		Cardinal.Tags = ConstructCardinalTags_8Way();
-		Cardinal.bEnabled = false;
+		if (Gaits.Contains(Pair.Key))
+		{
+			continue;
+		}
+		int32 Index = Speeds.Num();
+		while (Index > 0 && Speeds[Index - 1] > Pair.Value)
+		{
+			Index--;
+		}
+		Gaits.Insert(Pair.Key, Index);
+		Speeds.Insert(Pair.Value, Index);
 	}
-	// 10-Way
+
+	// Midpoints - use the gait we are closest to
+	// The first threshold that Speed is below selects the gait, with a running maximum that is the same as counting
+	Thresholds.Reset();
+	float MaxThreshold = -UE_BIG_NUMBER;
+	for (int32 i = 0; i < Speeds.Num() - 1; i++)
 	{
-		FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Strafe_10Way);
-		Cardinal.Tags = ConstructCardinalTags_10Way();
-		Cardinal.bEnabled = false;
+		MaxThreshold = FMath::Max(MaxThreshold, (Speeds[i] + Speeds[i + 1]) * 0.5f);
+		Thresholds.Add(MaxThreshold);
 	}
+}
 
-	// Start 1-Way
+const FGameplayTag& FSimpleGaitClassifier::Classify(float Speed, const FGameplayTag& CurrentGait, float Hysteresis) const
+{
+	if (Gaits.Num() == 0)
 	{
-		FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Start_1Way);
-		Cardinal.Tags = ConstructCardinalTags_Start_1Way();
-		Cardinal.bEnabled = bEnableDefaultCardinals;
+		return FGameplayTag::EmptyTag;
 	}
-	// Start 2-Way
+
+	// Thresholds below the current gait must be undershot by Hysteresis, those above must be exceeded by it
+	const int32 CurrentIndex = Hysteresis > 0.f ? Gaits.IndexOfByKey(CurrentGait) : INDEX_NONE;
+
+	int32 Index = 0;
+	for (int32 i = 0; i < Thresholds.Num(); i++)
 	{
-		FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Start_2Way);
-		Cardinal.Tags = ConstructCardinalTags_Start_2Way();
-		Cardinal.bEnabled = false;
+		const float Band = CurrentIndex == INDEX_NONE ? 0.f : (i < CurrentIndex ? -Hysteresis : Hysteresis);
+		Index += Speed >= Thresholds[i] + Band ? 1 : 0;
 	}
-	// Start 4-Way
+	return Gaits[Index];
+}
+
+FGameplayTag FSimpleCardinal::GetCardinal(ESimpleCardinalType CardinalType, bool bOnWall) const
+{
+	switch (CardinalType)
 	{
-		FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Start_4Way);
-		Cardinal.Tags = ConstructCardinalTags_Start_4Way();
-		Cardinal.bEnabled = false;
+	case ESimpleCardinalType::Acceleration: return bOnWall ? AccelerationWall : Acceleration;
+	case ESimpleCardinalType::Velocity: return bOnWall ? VelocityWall : Velocity;
 	}
-	// Start 8-Way
+	return FGameplayTag::EmptyTag;
+}
+
+const FSimpleCardinalHistory& FSimpleCardinal::GetHistory(ESimpleCardinalType CardinalType, bool bOnWall) const
+{
+	if (CardinalType == ESimpleCardinalType::Acceleration)
 	{
-		FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Start_8Way);
-		Cardinal.Tags = ConstructCardinalTags_Start_8Way();
-		Cardinal.bEnabled = false;
+		return bOnWall ? AccelerationWallHistory : AccelerationHistory;
 	}
+	return bOnWall ? VelocityWallHistory : VelocityHistory;
+}
 
-	// Turn 1-Way
+void FSimpleCardinalHistory::Update(const FGameplayTag& PrevCardinal, const FGameplayTag& Cardinal, float DeltaTime)
+{
+	bChanged = Cardinal != PrevCardinal;
+	bFlipped = false;
+	if (!bChanged)
 	{
-		FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Turn_1Way);
-		Cardinal.Tags = ConstructCardinalTags_Turn_1Way();
-		Cardinal.bEnabled = false;
+		TimeInCardinal += DeltaTime;
+		return;
 	}
-	// Turn 4-Way
+
+	// Only compare against the opposite when both are valid, clearing the cardinal isn't a flip
+	bFlipped = PrevCardinal.IsValid() && Cardinal.IsValid() && Cardinal == USimpleStatics::GetSimpleOppositeCardinal(PrevCardinal);
+	FlipCount = Cardinal.IsValid() ? FlipCount + (bFlipped ? 1 : 0) : 0;
+	Previous = PrevCardinal;
+	TimeInCardinal = 0.f;
+
+	RecentHead = (RecentHead + 1) % NumRecent;
+	Recent[RecentHead] = Cardinal;
+}
+
+void FSimpleCardinals::ConstructDefaultCardinals(bool bEnableDefaultCardinals)
+{
+	Cardinals = GetDefaultCardinals(bEnableDefaultCardinals);
+}
+
+namespace SimpleCardinalDefaults
+{
+	static TMap<FGameplayTag, FSimpleCardinal> BuildDefaultCardinals(bool bEnableDefaultCardinals)
 	{
-		FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Turn_4Way);
-		Cardinal.Tags = ConstructCardinalTags_Turn_4Way();
-		Cardinal.bEnabled = false;
+		TMap<FGameplayTag, FSimpleCardinal> Cardinals;
+		Cardinals.Reserve(13);
+
+		// 1-Way
+		{
+			FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Strafe_1Way);
+			Cardinal.Tags = FSimpleCardinals::ConstructCardinalTags_1Way();
+			Cardinal.bEnabled = false;
+		}
+		// 2-Way
+		{
+			FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Strafe_2Way);
+			Cardinal.Tags = FSimpleCardinals::ConstructCardinalTags_2Way();
+			Cardinal.bEnabled = false;
+		}
+		// 4-Way
+		{
+			FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Strafe_4Way);
+			Cardinal.Tags = FSimpleCardinals::ConstructCardinalTags_4Way();
+			Cardinal.bEnabled = bEnableDefaultCardinals;
+		}
+		// 6-Way
+		{
+			FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Strafe_6Way);
+			Cardinal.Tags = FSimpleCardinals::ConstructCardinalTags_6Way();
+			Cardinal.bEnabled = false;
+		}
+		// 8-Way
+		{
+			FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Strafe_8Way);
+			Cardinal.Tags = FSimpleCardinals::ConstructCardinalTags_8Way();
+			Cardinal.bEnabled = false;
+		}
+		// 10-Way
+		{
+			FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Strafe_10Way);
+			Cardinal.Tags = FSimpleCardinals::ConstructCardinalTags_10Way();
+			Cardinal.bEnabled = false;
+		}
+
+		// Start 1-Way
+		{
+			FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Start_1Way);
+			Cardinal.Tags = FSimpleCardinals::ConstructCardinalTags_Start_1Way();
+			Cardinal.bEnabled = bEnableDefaultCardinals;
+		}
+		// Start 2-Way
+		{
+			FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Start_2Way);
+			Cardinal.Tags = FSimpleCardinals::ConstructCardinalTags_Start_2Way();
+			Cardinal.bEnabled = false;
+		}
+		// Start 4-Way
+		{
+			FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Start_4Way);
+			Cardinal.Tags = FSimpleCardinals::ConstructCardinalTags_Start_4Way();
+			Cardinal.bEnabled = false;
+		}
+		// Start 8-Way
+		{
+			FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Start_8Way);
+			Cardinal.Tags = FSimpleCardinals::ConstructCardinalTags_Start_8Way();
+			Cardinal.bEnabled = false;
+		}
+
+		// Turn 1-Way
+		{
+			FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Turn_1Way);
+			Cardinal.Tags = FSimpleCardinals::ConstructCardinalTags_Turn_1Way();
+			Cardinal.bEnabled = false;
+		}
+		// Turn 4-Way
+		{
+			FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Turn_4Way);
+			Cardinal.Tags = FSimpleCardinals::ConstructCardinalTags_Turn_4Way();
+			Cardinal.bEnabled = false;
+		}
+		// Turn 8-Way
+		{
+			FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Turn_8Way);
+			Cardinal.Tags = FSimpleCardinals::ConstructCardinalTags_Turn_8Way();
+			Cardinal.bEnabled = false;
+		}
+
+		return Cardinals;
 	}
-	// Turn 8-Way
+}
+
+const TMap<FGameplayTag, FSimpleCardinal>& FSimpleCardinals::GetDefaultCardinals(bool bEnableDefaultCardinals)
+{
+	// Function-local statics are initialized once and thread-safe, FNativeGameplayTag values are valid from static init
+	if (bEnableDefaultCardinals)
 	{
-		FSimpleCardinal& Cardinal = Cardinals.Add(FSimpleTags::Simple_Mode_Turn_8Way);
-		Cardinal.Tags = ConstructCardinalTags_Turn_8Way();
-		Cardinal.bEnabled = false;
+		static const TMap<FGameplayTag, FSimpleCardinal> Enabled = SimpleCardinalDefaults::BuildDefaultCardinals(true);
+		return Enabled;
 	}
+	static const TMap<FGameplayTag, FSimpleCardinal> Disabled = SimpleCardinalDefaults::BuildDefaultCardinals(false);
+	return Disabled;
 }
 
 FGameplayTagContainer FSimpleCardinals::ConstructCardinalTags_1Way()
@@ -334,33 +467,46 @@ void FSimpleCardinals::SetCardinalEnabled(const FGameplayTag& CardinalModeTag, b
 	}
 }
 
-FGameplayTag FSimpleCardinals::GetCurrentCardinal(const FGameplayTag& CardinalModeTag, ESimpleCardinalType CardinalType, bool bOnWall) const
+const FSimpleCardinal* FSimpleCardinals::FindResult(const FGameplayTag& CardinalModeTag, const ANSICHAR* Context) const
 {
 	if (CardinalModeTag == FGameplayTag::EmptyTag || !bHasEverUpdated)
 	{
-		return FGameplayTag::EmptyTag;
+		return nullptr;
 	}
 	
-	const TMap<FGameplayTag, FSimpleCardinal>& CurrentCardinals = GetCardinals(ESimpleCardinalCache::CachedEnabledOnly);
-	if (CurrentCardinals.Num() == 0)
+	if (!Config.IsValid())
 	{
 		// Cardinals have not been initialized, likely due to race condition with anim layer initialization
-		return FGameplayTag::EmptyTag;
+		return nullptr;
 	}
 	
-	if (const FSimpleCardinal* MatchingCardinal = CurrentCardinals.Find(CardinalModeTag))
+	const int32 Index = Config->IndexOfMode(CardinalModeTag);
+	if (Results.IsValidIndex(Index))
 	{
-		if (LIKELY(ensure(MatchingCardinal->bEnabled)))  // Probably shouldn't have been cached if it can be false
-		{
-			return MatchingCardinal->GetCardinal(CardinalType, bOnWall);
-		}
-	}
-	else
-	{
-		UE_LOG(LogSimpleTypes, Warning, TEXT("[ %s ] wants Cardinal { %s } but it has not been enabled"), *FString(__FUNCTION__), *CardinalModeTag.ToString());
+		return &Results[Index];
 	}
+	
+	UE_LOG(LogSimpleTypes, Warning, TEXT("[ %s ] wants Cardinal { %s } but it has not been enabled"), *FString(Context), *CardinalModeTag.ToString());
 	ensure(false);  // This cardinal hasn't been enabled on the layer!
-	return FGameplayTag::EmptyTag;
+	return nullptr;
+}
+
+FGameplayTag FSimpleCardinals::GetCurrentCardinal(const FGameplayTag& CardinalModeTag, ESimpleCardinalType CardinalType, bool bOnWall) const
+{
+	const FSimpleCardinal* Result = FindResult(CardinalModeTag, __FUNCTION__);
+	return Result ? Result->GetCardinal(CardinalType, bOnWall) : FGameplayTag::EmptyTag;
+}
+
+FSimpleCardinal FSimpleCardinals::GetCurrentResult(const FGameplayTag& CardinalModeTag) const
+{
+	const FSimpleCardinal* Result = FindResult(CardinalModeTag, __FUNCTION__);
+	return Result ? *Result : FSimpleCardinal();
+}
+
+FSimpleCardinalHistory FSimpleCardinals::GetCurrentHistory(const FGameplayTag& CardinalModeTag, ESimpleCardinalType CardinalType, bool bOnWall) const
+{
+	const FSimpleCardinal* Result = FindResult(CardinalModeTag, __FUNCTION__);
+	return Result ? Result->GetHistory(CardinalType, bOnWall) : FSimpleCardinalHistory();
 }
 
 FGameplayTag FSimpleCardinals::GetCurrentCardinal(const FSimpleStrafeLocoSet& LocomotionSet, bool bOnWall) const
@@ -415,38 +561,35 @@ float FSimpleCardinals::GetDirectionAngle(ESimpleCardinalType CardinalType, bool
 	return 0.f;
 }
 
-void FSimpleCardinals::ThreadSafeUpdate(const FSimpleMovement& World2D, const FSimpleMovement& World, const FRotator& WorldRotation, bool bOnWall)
+void FSimpleCardinals::ThreadSafeUpdate(const FSimpleMovement& World2D, const FSimpleMovement& World, const FQuat& WorldQuat, bool bOnWall)
 {
-	ThreadSafeUpdate_Internal(World2D, World, WorldRotation, bOnWall);
+	ThreadSafeUpdate_Internal(World2D, World, WorldQuat, bOnWall);
 
-	// Update all cardinals - these are bound in USimpleAnimInstance::NativeInitializeAnimation
-	for (auto& CardinalItr : GetCardinals())
+	// Update all enabled cardinals - bound in USimpleAnimInstance::NativeInitializeAnimation
+	if (Config.IsValid() && UpdateDelegate.IsBound())
 	{
-		FSimpleCardinal& Cardinal = CardinalItr.Value;
-		if (LIKELY(ensure(Cardinal.bEnabled)))  // Probably shouldn't have been cached if it can be false
+		for (int32 Index = 0; Index < Results.Num(); Index++)
 		{
-			const FGameplayTag& ModeTag = CardinalItr.Key;
-			ensure(Cardinal.UpdateDelegate.ExecuteIfBound(ModeTag, Cardinal, *this));
+			UpdateDelegate.Execute(Config->Modes[Index].Mode, Results[Index], *this);
 		}
 	}
 	
 	bHasEverUpdated = true;
 }
 
-void FSimpleCardinals::ThreadSafeUpdate_Internal(const FSimpleMovement& World2D, const FSimpleMovement& World, const FRotator& WorldRotation, bool bOnWall)
+void FSimpleCardinals::ThreadSafeUpdate_Internal(const FSimpleMovement& World2D, const FSimpleMovement& World, const FQuat& WorldQuat, bool bOnWall)
 {
-	if (!bHasCachedCardinals)
-	{
-		CacheCardinals();
-	}
+	const FVector ForwardVector = WorldQuat.GetForwardVector();
+	const FVector RightVector = WorldQuat.GetRightVector();
 	
-	Velocity = CalculateDirection(World2D.Velocity, WorldRotation);
-	Acceleration = CalculateDirection(World2D.Acceleration, WorldRotation);
+	Velocity = CalculateDirection(World2D.Velocity, ForwardVector, RightVector);
+	Acceleration = CalculateDirection(World2D.Acceleration, ForwardVector, RightVector);
 	
 	if (bOnWall)
 	{
-		VelocityWall = CalculateDirectionWall(World.Velocity, WorldRotation);
-		AccelerationWall = CalculateDirectionWall(World.Acceleration, WorldRotation);
+		const FVector UpVector = WorldQuat.GetUpVector();
+		VelocityWall = CalculateDirectionWall(World.Velocity, UpVector, RightVector);
+		AccelerationWall = CalculateDirectionWall(World.Acceleration, UpVector, RightVector);
 	}
 	else
 	{
@@ -462,8 +605,16 @@ float FSimpleCardinals::CalculateDirection(const FVector& Velocity, const FRotat
 	if (!Velocity.IsNearlyZero())
 	{
 		const FMatrix RotMatrix = FRotationMatrix(BaseRotation);
-		const FVector ForwardVector = RotMatrix.GetScaledAxis(EAxis::X);
-		const FVector RightVector = RotMatrix.GetScaledAxis(EAxis::Y);
+		return CalculateDirection(Velocity, RotMatrix.GetScaledAxis(EAxis::X), RotMatrix.GetScaledAxis(EAxis::Y));
+	}
+
+	return 0.f;
+}
+
+float FSimpleCardinals::CalculateDirection(const FVector& Velocity, const FVector& ForwardVector, const FVector& RightVector)
+{
+	if (!Velocity.IsNearlyZero())
+	{
 		const FVector NormalizedVel = Velocity.GetSafeNormal2D();
 
 		// get a cos(alpha) of forward vector vs velocity
@@ -489,8 +640,16 @@ float FSimpleCardinals::CalculateDirectionWall(const FVector& Velocity, const FR
 	if (!Velocity.IsNearlyZero())
 	{
 		const FMatrix RotMatrix = FRotationMatrix(BaseRotation);
-		const FVector UpVector = RotMatrix.GetScaledAxis(EAxis::Z);
-		const FVector RightVector = RotMatrix.GetScaledAxis(EAxis::Y);
+		return CalculateDirectionWall(Velocity, RotMatrix.GetScaledAxis(EAxis::Z), RotMatrix.GetScaledAxis(EAxis::Y));
+	}
+
+	return 0.f;
+}
+
+float FSimpleCardinals::CalculateDirectionWall(const FVector& Velocity, const FVector& UpVector, const FVector& RightVector)
+{
+	if (!Velocity.IsNearlyZero())
+	{
 		const FVector NormalizedVel = Velocity.GetSafeNormal();
 
 		// get a cos(alpha) of up vector vs velocity
@@ -511,41 +670,48 @@ float FSimpleCardinals::CalculateDirectionWall(const FVector& Velocity, const FR
 	return 0.f;
 }
 
-void FSimpleCardinals::UpdateCardinals(const TMap<FGameplayTag, FSimpleCardinal>& NewCardinals)
+void FSimpleCardinals::SetConfig(const TSharedPtr<const FSimpleCardinalConfig>& InConfig)
 {
-	Cardinals = NewCardinals;
-	CacheCardinals();
+	Config = InConfig;
+	Results.Reset();
+	Results.SetNum(Config.IsValid() ? Config->Modes.Num() : 0);
+	for (int32 Index = 0; Index < Results.Num(); Index++)
+	{
+		Results[Index].bEnabled = true;
+	}
 }
 
-void FSimpleCardinals::CacheCardinals()
+TSharedRef<const FSimpleCardinalConfig> FSimpleCardinalConfig::Build(const TMap<FGameplayTag, FSimpleCardinal>& Cardinals,
+	TFunctionRef<float(const FGameplayTag&)> GetDeadZone)
 {
-	CachedCardinals.Reset();
-	for (auto& CardinalItr : Cardinals)
+	TSharedRef<FSimpleCardinalConfig> Config = MakeShared<FSimpleCardinalConfig>();
+	for (const auto& CardinalItr : Cardinals)
 	{
-		const FSimpleCardinal& Cardinal = CardinalItr.Value;
-		if (Cardinal.bEnabled)
+		if (CardinalItr.Value.bEnabled)
 		{
-			CachedCardinals.Add(CardinalItr);
+			FMode& Mode = Config->Modes.AddDefaulted_GetRef();
+			Mode.Mode = CardinalItr.Key;
+			Mode.Tags = CardinalItr.Value.Tags;
+			Mode.DeadZone = GetDeadZone(CardinalItr.Key);
 		}
 	}
-	bHasCachedCardinals = true;
+	return Config;
 }
 
-const TMap<FGameplayTag, FSimpleCardinal>& FSimpleCardinals::GetCardinals(ESimpleCardinalCache Mode) const
+TMap<FGameplayTag, FSimpleCardinal> FSimpleCardinals::GetCardinals(ESimpleCardinalCache Mode) const
 {
-	if (!bHasCachedCardinals && Mode == ESimpleCardinalCache::CachedEnabledOnly)
+	if (Mode == ESimpleCardinalCache::IncludeDisabled)
 	{
-		FSimpleCardinals* MutableThis = const_cast<FSimpleCardinals*>(this);
-		MutableThis->CacheCardinals();
+		return Cardinals;
 	}
-	return Mode == ESimpleCardinalCache::IncludeDisabled ? Cardinals : CachedCardinals;
-}
 
-TMap<FGameplayTag, FSimpleCardinal>& FSimpleCardinals::GetCardinals(ESimpleCardinalCache Mode)
-{
-	if (!bHasCachedCardinals && Mode == ESimpleCardinalCache::CachedEnabledOnly)
+	TMap<FGameplayTag, FSimpleCardinal> Result;
+	if (Config.IsValid())
 	{
-		CacheCardinals();
+		for (int32 Index = 0; Index < Results.Num(); Index++)
+		{
+			Result.Add(Config->Modes[Index].Mode, Results[Index]);
+		}
 	}
-	return Mode == ESimpleCardinalCache::IncludeDisabled ? Cardinals : CachedCardinals;
+	return Result;
 }
\ No newline at end of file
@@ -0,0 +1,705 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "SimpleValidation.h"
+
+#if WITH_SIMPLE_VALIDATION
+
+#include "SimpleAnimInstance.h"
+#include "SimpleStatics.h"
+#include "SimpleTags.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Algo/Unique.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Misc/AutomationTest.h"
+#include <cmath>
+
+DEFINE_LOG_CATEGORY_STATIC(LogSimpleValidation, Log, All);
+
+namespace SimpleValidation
+{
+	static constexpr int32 MaxReportedMismatches = 10;
+
+	/** CalculateDirection is allowed to differ by this many degrees, acos is poorly conditioned near 0 and 180 */
+	static constexpr float DirectionTolerance = 0.01f;
+
+	static FAutoConsoleCommand ValidateCommand(
+		TEXT("a.SimpleAnim.Validate"),
+		TEXT("Sweep every registered cardinal and gait candidate against the reference implementation. Optional: AngleStep CandidateFilter"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const float AngleStep = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 0.1f;
+			FSimpleValidation::RunValidation(AngleStep, Args.Num() > 1 ? Args[1] : FString());
+		})
+	);
+
+	struct FCandidates
+	{
+		TMap<FName, FSimpleSelectCardinalFunc> SelectCardinal;
+		TMap<FName, FSimpleSelectBasicCardinalFunc> SelectBasicCardinal;
+		TMap<FName, FSimpleCalculateDirectionFunc> CalculateDirection;
+		TMap<FName, FSimpleGaitModeFunc> GaitMode;
+	};
+
+	static FCandidates& GetCandidates()
+	{
+		static FCandidates Candidates;
+		return Candidates;
+	}
+
+	/**
+	 * Frozen copy of the original implementations, this is the oracle every candidate is compared to
+	 * Do not optimize or otherwise change these, change the live implementation instead
+	 */
+	namespace Reference
+	{
+		using namespace FSimpleTags;
+
+		static FGameplayTag TurnFromSign(float Angle)
+		{
+			return Angle >= 0.f ? Simple_Cardinal_BackwardTurnRight : Simple_Cardinal_BackwardTurnLeft;
+		}
+
+		/** bRemapTurnForward is the only difference between the basic and full selection besides the dead zone */
+		static FGameplayTag SelectCardinal(const FGameplayTag& Mode, float Angle, float DeadZone,
+			const FGameplayTag& CurrentDirection, bool bWasMovingLastUpdate, bool bRemapTurnForward)
+		{
+			const float AngleAbs = FMath::Abs(Angle);
+			const bool bRight = Angle >= 0.f;
+
+			float DeadZoneFwd = DeadZone;
+			float DeadZoneBwd = DeadZone;
+			if (bWasMovingLastUpdate)
+			{
+				DeadZoneFwd *= CurrentDirection == Simple_Cardinal_Forward ? 2.f : 1.f;
+				DeadZoneBwd *= CurrentDirection == Simple_Cardinal_Backward ? 2.f : 1.f;
+			}
+
+			if (Mode == Simple_Mode_Strafe_1Way || Mode == Simple_Mode_Start_1Way)
+			{
+				return Simple_Cardinal_Forward;
+			}
+			if (Mode == Simple_Mode_Strafe_2Way)
+			{
+				if (bWasMovingLastUpdate && CurrentDirection == Simple_Cardinal_Left)
+				{
+					DeadZone *= -1.f;
+				}
+				return Angle > 0.f + DeadZone ? Simple_Cardinal_Right : Simple_Cardinal_Left;
+			}
+			if (Mode == Simple_Mode_Strafe_4Way)
+			{
+				if (AngleAbs <= 45.f + DeadZoneFwd) { return Simple_Cardinal_Forward; }
+				if (AngleAbs >= 135.f - DeadZoneBwd) { return Simple_Cardinal_Backward; }
+				return Angle > 0.f ? Simple_Cardinal_Right : Simple_Cardinal_Left;
+			}
+			if (Mode == Simple_Mode_Strafe_6Way)
+			{
+				if (AngleAbs <= 45.f + DeadZoneFwd) { return Simple_Cardinal_Forward; }
+				if (AngleAbs >= 135.f - DeadZoneBwd) { return Simple_Cardinal_Backward; }
+				if (AngleAbs <= 90.f + DeadZoneFwd) { return bRight ? Simple_Cardinal_Right : Simple_Cardinal_Left; }
+				return bRight ? Simple_Cardinal_Right_Away : Simple_Cardinal_Left_Away;
+			}
+			if (Mode == Simple_Mode_Strafe_8Way || Mode == Simple_Mode_Strafe_10Way)
+			{
+				if (AngleAbs <= 22.5f + DeadZoneFwd) { return Simple_Cardinal_Forward; }
+				if (AngleAbs >= 157.5f - DeadZoneBwd) { return Simple_Cardinal_Backward; }
+				if (AngleAbs <= 67.5f) { return Angle > 0.f ? Simple_Cardinal_Forward_Right : Simple_Cardinal_Forward_Left; }
+				if (AngleAbs >= 112.5f) { return Angle > 0.f ? Simple_Cardinal_Backward_Right : Simple_Cardinal_Backward_Left; }
+				if (Mode == Simple_Mode_Strafe_8Way)
+				{
+					return Angle > 0.f ? Simple_Cardinal_Right : Simple_Cardinal_Left;
+				}
+				if (AngleAbs <= 90.f + DeadZoneFwd) { return bRight ? Simple_Cardinal_Right : Simple_Cardinal_Left; }
+				return bRight ? Simple_Cardinal_Right_Away : Simple_Cardinal_Left_Away;
+			}
+			if (Mode == Simple_Mode_Start_2Way)
+			{
+				return AngleAbs <= 90.f ? Simple_Cardinal_Forward : TurnFromSign(Angle);
+			}
+			if (Mode == Simple_Mode_Start_4Way || Mode == Simple_Mode_Start_8Way)
+			{
+				const FGameplayTag& Strafe = Mode == Simple_Mode_Start_4Way ? Simple_Mode_Strafe_4Way : Simple_Mode_Strafe_8Way;
+				const FGameplayTag Basic = SelectCardinal(Strafe, Angle, 0.f, FGameplayTag::EmptyTag, false, false);
+				return Basic == Simple_Cardinal_Backward ? TurnFromSign(Angle) : Basic;
+			}
+			if (Mode == Simple_Mode_Turn_1Way)
+			{
+				return TurnFromSign(Angle);
+			}
+			if (Mode == Simple_Mode_Turn_4Way || Mode == Simple_Mode_Turn_8Way)
+			{
+				const bool b4Way = Mode == Simple_Mode_Turn_4Way;
+				const FGameplayTag Basic = SelectCardinal(b4Way ? Simple_Mode_Strafe_4Way : Simple_Mode_Strafe_8Way,
+					Angle, 0.f, FGameplayTag::EmptyTag, false, false);
+				if (Basic == Simple_Cardinal_Forward && bRemapTurnForward)
+				{
+					if (b4Way)
+					{
+						return bRight ? Simple_Cardinal_Right : Simple_Cardinal_Left;
+					}
+					return bRight ? Simple_Cardinal_Forward_Right : Simple_Cardinal_Forward_Left;
+				}
+				return Basic == Simple_Cardinal_Backward ? TurnFromSign(Angle) : Basic;
+			}
+			return FGameplayTag::EmptyTag;
+		}
+
+		static FGameplayTag SelectSimpleCardinalFromAngle(const FGameplayTag& Mode, float Angle, float DeadZone,
+			const FGameplayTag& CurrentDirection, bool bWasMovingLastUpdate)
+		{
+			return SelectCardinal(Mode, Angle, DeadZone, CurrentDirection, bWasMovingLastUpdate, true);
+		}
+
+		static FGameplayTag SelectBasicCardinalFromAngle(const FGameplayTag& Mode, float Angle)
+		{
+			return SelectCardinal(Mode, Angle, 0.f, FGameplayTag::EmptyTag, false, false);
+		}
+
+		static float CalculateDirection(const FVector& Velocity, const FRotator& BaseRotation)
+		{
+			if (!Velocity.IsNearlyZero())
+			{
+				const FMatrix RotMatrix = FRotationMatrix(BaseRotation);
+				const FVector ForwardVector = RotMatrix.GetScaledAxis(EAxis::X);
+				const FVector RightVector = RotMatrix.GetScaledAxis(EAxis::Y);
+				const FVector NormalizedVel = Velocity.GetSafeNormal2D();
+
+				float ForwardDeltaDegree = FMath::RadiansToDegrees(FMath::Acos(static_cast<float>(FVector::DotProduct(ForwardVector, NormalizedVel))));
+				if (static_cast<float>(FVector::DotProduct(RightVector, NormalizedVel)) < 0.f)
+				{
+					ForwardDeltaDegree *= -1.f;
+				}
+				return ForwardDeltaDegree;
+			}
+			return 0.f;
+		}
+
+		static FSimpleGaitResult GaitMode(const FSimpleGaitInput& Input)
+		{
+			FSimpleGaitResult Result;
+
+			Result.StartGait = Input.bWantsSprinting ? Simple_Gait_Sprint : Input.bWantsWalking ? Simple_Gait_Walk :
+				Input.bWantsStrolling ? Simple_Gait_Stroll : Simple_Gait_Run;
+
+			Result.Gait = Input.bIsSprinting ? Simple_Gait_Sprint : Input.bIsWalking ? Simple_Gait_Walk :
+				Input.bIsStrolling ? Simple_Gait_Stroll : Simple_Gait_Run;
+
+			auto GetMaxSpeed = [&Input](const FGameplayTag& Tag)
+			{
+				const float* MaxSpeed = Input.MaxGaitSpeeds->MaxSpeeds.Find(Tag);
+				return MaxSpeed ? *MaxSpeed : 0.f;
+			};
+
+			const float MaxSpeedStroll = GetMaxSpeed(Simple_Gait_Stroll);
+			const float MaxSpeedWalk = GetMaxSpeed(Simple_Gait_Walk);
+			const float MaxSpeedRun = GetMaxSpeed(Simple_Gait_Run);
+			const float MaxSpeedSprint = GetMaxSpeed(Simple_Gait_Sprint);
+
+			const float MidSpeedWalk = (MaxSpeedWalk + MaxSpeedStroll) * 0.5f;
+			const float MidSpeedRun = (MaxSpeedRun + MaxSpeedWalk) * 0.5f;
+			const float MidSpeedSprint = (MaxSpeedSprint + MaxSpeedRun) * 0.5f;
+
+			Result.GaitSpeed = Input.Speed < MidSpeedWalk ? Simple_Gait_Stroll : Input.Speed < MidSpeedRun ? Simple_Gait_Walk :
+				Input.Speed < MidSpeedSprint ? Simple_Gait_Run : Simple_Gait_Sprint;
+
+			Result.StopGait = Input.bHasAcceleration ? Result.GaitSpeed : Input.PrevStopGait;
+			return Result;
+		}
+	}
+
+	static TArray<FGameplayTag> GetModes()
+	{
+		using namespace FSimpleTags;
+		return {
+			Simple_Mode_Strafe_1Way, Simple_Mode_Strafe_2Way, Simple_Mode_Strafe_4Way, Simple_Mode_Strafe_6Way,
+			Simple_Mode_Strafe_8Way, Simple_Mode_Strafe_10Way, Simple_Mode_Start_1Way, Simple_Mode_Start_2Way,
+			Simple_Mode_Start_4Way, Simple_Mode_Start_8Way, Simple_Mode_Turn_1Way, Simple_Mode_Turn_4Way, Simple_Mode_Turn_8Way
+		};
+	}
+
+	static TArray<FGameplayTag> GetDirections()
+	{
+		using namespace FSimpleTags;
+		return {
+			FGameplayTag::EmptyTag, Simple_Cardinal_Forward, Simple_Cardinal_Forward_Left, Simple_Cardinal_Forward_Right,
+			Simple_Cardinal_Left, Simple_Cardinal_Right, Simple_Cardinal_Left_Away, Simple_Cardinal_Right_Away,
+			Simple_Cardinal_Backward, Simple_Cardinal_Backward_Left, Simple_Cardinal_Backward_Right,
+			Simple_Cardinal_BackwardTurnLeft, Simple_Cardinal_BackwardTurnRight
+		};
+	}
+
+	static const TArray<float>& GetDeadZones()
+	{
+		static const TArray<float> DeadZones = { 0.f, 2.5f, 5.f, 7.5f, 10.f, 15.f, 20.f, 22.5f, 30.f, 45.f };
+		return DeadZones;
+	}
+
+	/** Linear sweep plus every boundary the reference uses, offset by each dead zone, and their neighbouring floats */
+	static TArray<float> BuildAngles(float AngleStep)
+	{
+		TArray<float> Angles;
+		const int32 NumSteps = FMath::CeilToInt32(360.0 / AngleStep);
+		Angles.Reserve(NumSteps + 1024);
+		for (int32 i = 0; i <= NumSteps; i++)
+		{
+			Angles.Add(static_cast<float>(FMath::Min(-180.0 + i * static_cast<double>(AngleStep), 180.0)));
+		}
+
+		static const float Boundaries[] = { 0.f, 22.5f, 45.f, 67.5f, 90.f, 112.5f, 135.f, 157.5f, 180.f };
+		for (const float Boundary : Boundaries)
+		{
+			for (const float DeadZone : GetDeadZones())
+			{
+				for (const float Offset : { 0.f, DeadZone, -DeadZone, DeadZone * 2.f, DeadZone * -2.f })
+				{
+					for (const float Sign : { 1.f, -1.f })
+					{
+						const float Angle = Sign * (Boundary + Offset);
+						if (FMath::Abs(Angle) <= 180.f)
+						{
+							Angles.Add(Angle);
+							Angles.Add(std::nextafter(Angle, 1000.f));
+							Angles.Add(std::nextafter(Angle, -1000.f));
+						}
+					}
+				}
+			}
+		}
+
+		Angles.Sort();
+		Angles.SetNum(Algo::Unique(Angles));
+		return Angles;
+	}
+
+	static bool PassesFilter(FName Name, const FString& Filter)
+	{
+		return Filter.IsEmpty() || Name.ToString().Contains(Filter);
+	}
+
+	static void ReportTiming(const TCHAR* Function, FName Name, double Seconds, double ReferenceSeconds, uint64 NumCalls, uint64 NumMismatches)
+	{
+		const double NsPerCall = NumCalls > 0 ? (Seconds * 1e9) / NumCalls : 0.0;
+		const double RefNsPerCall = NumCalls > 0 ? (ReferenceSeconds * 1e9) / NumCalls : 0.0;
+		UE_LOG(LogSimpleValidation, Display, TEXT("%-28s %-20s %10llu calls  %8.2fns (reference %8.2fns, %5.2fx)  %llu mismatches"),
+			Function, *Name.ToString(), NumCalls, NsPerCall, RefNsPerCall, NsPerCall > 0.0 ? RefNsPerCall / NsPerCall : 0.0, NumMismatches);
+	}
+
+	static bool ValidateSelectCardinal(const TArray<float>& Angles, const FString& Filter)
+	{
+		const TArray<FGameplayTag> Modes = GetModes();
+		const TArray<FGameplayTag> Directions = GetDirections();
+		const TArray<float>& DeadZones = GetDeadZones();
+
+		bool bPassed = true;
+		for (const TPair<FName, FSimpleSelectCardinalFunc>& Candidate : GetCandidates().SelectCardinal)
+		{
+			if (!PassesFilter(Candidate.Key, Filter))
+			{
+				continue;
+			}
+
+			double Seconds = 0.0;
+			double ReferenceSeconds = 0.0;
+			uint64 NumCalls = 0;
+			uint64 NumMismatches = 0;
+
+			TArray<FGameplayTag> Expected;
+			TArray<FGameplayTag> Actual;
+			for (const FGameplayTag& Mode : Modes)
+			{
+				// Results are batched per mode so timing isn't dominated by the comparison
+				auto Sweep = [&](TArray<FGameplayTag>& Results, auto&& Func)
+				{
+					Results.Reset(Angles.Num() * DeadZones.Num() * Directions.Num() * 2);
+					const double Start = FPlatformTime::Seconds();
+					for (const bool bWasMoving : { false, true })
+					{
+						for (const FGameplayTag& Direction : Directions)
+						{
+							for (const float DeadZone : DeadZones)
+							{
+								for (const float Angle : Angles)
+								{
+									Results.Add(Func(Mode, Angle, DeadZone, Direction, bWasMoving));
+								}
+							}
+						}
+					}
+					return FPlatformTime::Seconds() - Start;
+				};
+
+				ReferenceSeconds += Sweep(Expected, &Reference::SelectSimpleCardinalFromAngle);
+				Seconds += Sweep(Actual, Candidate.Value);
+				NumCalls += Expected.Num();
+
+				for (int32 i = 0; i < Expected.Num(); i++)
+				{
+					if (Expected[i] != Actual[i])
+					{
+						if (NumMismatches++ < MaxReportedMismatches)
+						{
+							const int32 AngleIndex = i % Angles.Num();
+							const int32 DeadZoneIndex = (i / Angles.Num()) % DeadZones.Num();
+							const int32 DirectionIndex = (i / (Angles.Num() * DeadZones.Num())) % Directions.Num();
+							const bool bWasMoving = i >= Expected.Num() / 2;
+							UE_LOG(LogSimpleValidation, Warning, TEXT("SelectSimpleCardinalFromAngle [ %s ] Mode { %s } Angle { %.9g } DeadZone { %.2f } Current { %s } WasMoving { %s }: expected { %s } got { %s }"),
+								*Candidate.Key.ToString(), *Mode.ToString(), Angles[AngleIndex], DeadZones[DeadZoneIndex],
+								*Directions[DirectionIndex].ToString(), bWasMoving ? TEXT("true") : TEXT("false"),
+								*Expected[i].ToString(), *Actual[i].ToString());
+						}
+					}
+				}
+			}
+
+			ReportTiming(TEXT("SelectSimpleCardinalFromAngle"), Candidate.Key, Seconds, ReferenceSeconds, NumCalls, NumMismatches);
+			bPassed &= NumMismatches == 0;
+		}
+		return bPassed;
+	}
+
+	static bool ValidateSelectBasicCardinal(const TArray<float>& Angles, const FString& Filter)
+	{
+		const TArray<FGameplayTag> Modes = GetModes();
+
+		bool bPassed = true;
+		for (const TPair<FName, FSimpleSelectBasicCardinalFunc>& Candidate : GetCandidates().SelectBasicCardinal)
+		{
+			if (!PassesFilter(Candidate.Key, Filter))
+			{
+				continue;
+			}
+
+			double Seconds = 0.0;
+			double ReferenceSeconds = 0.0;
+			uint64 NumCalls = 0;
+			uint64 NumMismatches = 0;
+
+			TArray<FGameplayTag> Expected;
+			TArray<FGameplayTag> Actual;
+			for (const FGameplayTag& Mode : Modes)
+			{
+				auto Sweep = [&](TArray<FGameplayTag>& Results, auto&& Func)
+				{
+					Results.Reset(Angles.Num());
+					const double Start = FPlatformTime::Seconds();
+					for (const float Angle : Angles)
+					{
+						Results.Add(Func(Mode, Angle));
+					}
+					return FPlatformTime::Seconds() - Start;
+				};
+
+				ReferenceSeconds += Sweep(Expected, &Reference::SelectBasicCardinalFromAngle);
+				Seconds += Sweep(Actual, Candidate.Value);
+				NumCalls += Expected.Num();
+
+				for (int32 i = 0; i < Expected.Num(); i++)
+				{
+					if (Expected[i] != Actual[i] && NumMismatches++ < MaxReportedMismatches)
+					{
+						UE_LOG(LogSimpleValidation, Warning, TEXT("SelectBasicCardinalFromAngle [ %s ] Mode { %s } Angle { %.9g }: expected { %s } got { %s }"),
+							*Candidate.Key.ToString(), *Mode.ToString(), Angles[i], *Expected[i].ToString(), *Actual[i].ToString());
+					}
+				}
+			}
+
+			ReportTiming(TEXT("SelectBasicCardinalFromAngle"), Candidate.Key, Seconds, ReferenceSeconds, NumCalls, NumMismatches);
+			bPassed &= NumMismatches == 0;
+		}
+		return bPassed;
+	}
+
+	static bool ValidateCalculateDirection(float AngleStep, const FString& Filter)
+	{
+		// Two-dimensional sweep, so this is coarser than the cardinal sweep
+		const float YawStep = FMath::Max(1.f, AngleStep * 10.f);
+		TArray<FRotator> Rotations;
+		TArray<FVector> Velocities;
+		for (float Yaw = -180.f; Yaw <= 180.f; Yaw += YawStep)
+		{
+			for (const FVector2f& PitchRoll : { FVector2f(0.f, 0.f), FVector2f(10.f, 0.f), FVector2f(0.f, 20.f), FVector2f(-45.f, 30.f) })
+			{
+				Rotations.Add(FRotator(PitchRoll.X, Yaw, PitchRoll.Y));
+			}
+			for (const float Magnitude : { 1e-5f, 1.f, 600.f })
+			{
+				for (const float Z : { 0.f, 50.f })
+				{
+					Velocities.Add(FRotator(0.f, Yaw, 0.f).Vector() * Magnitude + FVector(0.f, 0.f, Z));
+				}
+			}
+		}
+
+		bool bPassed = true;
+		for (const TPair<FName, FSimpleCalculateDirectionFunc>& Candidate : GetCandidates().CalculateDirection)
+		{
+			if (!PassesFilter(Candidate.Key, Filter))
+			{
+				continue;
+			}
+
+			uint64 NumMismatches = 0;
+			TArray<float> Expected;
+			TArray<float> Actual;
+
+			auto Sweep = [&](TArray<float>& Results, auto&& Func)
+			{
+				Results.Reset(Rotations.Num() * Velocities.Num());
+				const double Start = FPlatformTime::Seconds();
+				for (const FRotator& Rotation : Rotations)
+				{
+					for (const FVector& Velocity : Velocities)
+					{
+						Results.Add(Func(Velocity, Rotation));
+					}
+				}
+				return FPlatformTime::Seconds() - Start;
+			};
+
+			const double ReferenceSeconds = Sweep(Expected, &Reference::CalculateDirection);
+			const double Seconds = Sweep(Actual, Candidate.Value);
+
+			for (int32 i = 0; i < Expected.Num(); i++)
+			{
+				// +180 and -180 are the same direction
+				const float Delta = FMath::Abs(FRotator::NormalizeAxis(Expected[i] - Actual[i]));
+				if (Delta > DirectionTolerance && NumMismatches++ < MaxReportedMismatches)
+				{
+					UE_LOG(LogSimpleValidation, Warning, TEXT("CalculateDirection [ %s ] Velocity { %s } Rotation { %s }: expected { %.6f } got { %.6f }"),
+						*Candidate.Key.ToString(), *Velocities[i % Velocities.Num()].ToString(), *Rotations[i / Velocities.Num()].ToString(),
+						Expected[i], Actual[i]);
+				}
+			}
+
+			ReportTiming(TEXT("CalculateDirection"), Candidate.Key, Seconds, ReferenceSeconds, Expected.Num(), NumMismatches);
+			bPassed &= NumMismatches == 0;
+		}
+		return bPassed;
+	}
+
+	static bool ValidateGaitMode(const FString& Filter)
+	{
+		using namespace FSimpleTags;
+
+		auto MakeSpeeds = [](float Stroll, float Walk, float Run, float Sprint)
+		{
+			FSimpleGaitSpeed Speeds;
+			Speeds.MaxSpeeds.Add(Simple_Gait_Stroll, Stroll);
+			Speeds.MaxSpeeds.Add(Simple_Gait_Walk, Walk);
+			Speeds.MaxSpeeds.Add(Simple_Gait_Run, Run);
+			Speeds.MaxSpeeds.Add(Simple_Gait_Sprint, Sprint);
+			return Speeds;
+		};
+
+		const TArray<FSimpleGaitSpeed> SpeedTables = {
+			MakeSpeeds(75.f, 200.f, 500.f, 700.f),
+			MakeSpeeds(0.f, 250.f, 250.f, 600.f),		// Walk and run share a speed
+			MakeSpeeds(100.f, 100.f, 100.f, 100.f),		// All the same
+			MakeSpeeds(150.f, 300.f, 600.f, 450.f),		// Sprint slower than run
+		};
+
+		TArray<FSimpleGaitInput> Inputs;
+		for (const FSimpleGaitSpeed& Table : SpeedTables)
+		{
+			TArray<float> Speeds;
+			for (int32 Speed = 0; Speed <= 1000; Speed++)
+			{
+				Speeds.Add(static_cast<float>(Speed));
+			}
+			for (const TPair<FGameplayTag, float>& A : Table.MaxSpeeds)
+			{
+				for (const TPair<FGameplayTag, float>& B : Table.MaxSpeeds)
+				{
+					const float Mid = (A.Value + B.Value) * 0.5f;
+					Speeds.Append({ Mid, std::nextafter(Mid, 0.f), std::nextafter(Mid, 10000.f) });
+				}
+			}
+
+			for (const float Speed : Speeds)
+			{
+				for (int32 Flags = 0; Flags < (1 << 7); Flags++)
+				{
+					for (const FGameplayTag& PrevStopGait : { FGameplayTag::EmptyTag, Simple_Gait_Walk.GetTag() })
+					{
+						FSimpleGaitInput& Input = Inputs.AddDefaulted_GetRef();
+						Input.MaxGaitSpeeds = &Table;
+						Input.Speed = Speed;
+						Input.bIsStrolling = (Flags & (1 << 0)) != 0;
+						Input.bIsWalking = (Flags & (1 << 1)) != 0;
+						Input.bIsSprinting = (Flags & (1 << 2)) != 0;
+						Input.bWantsStrolling = (Flags & (1 << 3)) != 0;
+						Input.bWantsWalking = (Flags & (1 << 4)) != 0;
+						Input.bWantsSprinting = (Flags & (1 << 5)) != 0;
+						Input.bHasAcceleration = (Flags & (1 << 6)) != 0;
+						Input.PrevStopGait = PrevStopGait;
+					}
+				}
+			}
+		}
+
+		bool bPassed = true;
+		for (const TPair<FName, FSimpleGaitModeFunc>& Candidate : GetCandidates().GaitMode)
+		{
+			if (!PassesFilter(Candidate.Key, Filter))
+			{
+				continue;
+			}
+
+			uint64 NumMismatches = 0;
+			TArray<FSimpleGaitResult> Expected;
+			TArray<FSimpleGaitResult> Actual;
+
+			auto Sweep = [&](TArray<FSimpleGaitResult>& Results, auto&& Func)
+			{
+				Results.Reset(Inputs.Num());
+				const double Start = FPlatformTime::Seconds();
+				for (const FSimpleGaitInput& Input : Inputs)
+				{
+					Results.Add(Func(Input));
+				}
+				return FPlatformTime::Seconds() - Start;
+			};
+
+			const double ReferenceSeconds = Sweep(Expected, &Reference::GaitMode);
+			const double Seconds = Sweep(Actual, Candidate.Value);
+
+			for (int32 i = 0; i < Expected.Num(); i++)
+			{
+				if (!(Expected[i] == Actual[i]) && NumMismatches++ < MaxReportedMismatches)
+				{
+					UE_LOG(LogSimpleValidation, Warning, TEXT("GaitMode [ %s ] Speed { %.9g }: expected { %s %s %s %s } got { %s %s %s %s }"),
+						*Candidate.Key.ToString(), Inputs[i].Speed,
+						*Expected[i].Gait.ToString(), *Expected[i].StartGait.ToString(), *Expected[i].GaitSpeed.ToString(), *Expected[i].StopGait.ToString(),
+						*Actual[i].Gait.ToString(), *Actual[i].StartGait.ToString(), *Actual[i].GaitSpeed.ToString(), *Actual[i].StopGait.ToString());
+				}
+			}
+
+			ReportTiming(TEXT("NativeThreadSafeUpdateGaitMode"), Candidate.Key, Seconds, ReferenceSeconds, Expected.Num(), NumMismatches);
+			bPassed &= NumMismatches == 0;
+		}
+		return bPassed;
+	}
+
+	/** The live gait update is driven through a transient anim instance so overrides of the virtual are covered too */
+	static void RegisterLiveCandidates()
+	{
+		static TStrongObjectPtr<USkeletalMeshComponent> Outer;
+		static TStrongObjectPtr<USimpleAnimInstance> Instance;
+		if (!Instance.IsValid())
+		{
+			Outer.Reset(NewObject<USkeletalMeshComponent>(GetTransientPackage()));
+			Instance.Reset(NewObject<USimpleAnimInstance>(Outer.Get()));
+		}
+
+		FSimpleValidation::RegisterSelectCardinal(TEXT("Live"), &USimpleStatics::SelectSimpleCardinalFromAngle);
+		FSimpleValidation::RegisterSelectBasicCardinal(TEXT("Live"), &USimpleStatics::SelectBasicCardinalFromAngle);
+		FSimpleValidation::RegisterCalculateDirection(TEXT("Live"), static_cast<float(*)(const FVector&, const FRotator&)>(&FSimpleCardinals::CalculateDirection));
+		FSimpleValidation::RegisterCalculateDirection(TEXT("LiveBasis"), [](const FVector& Velocity, const FRotator& BaseRotation)
+		{
+			const FQuat Quat = BaseRotation.Quaternion();
+			return FSimpleCardinals::CalculateDirection(Velocity, Quat.GetForwardVector(), Quat.GetRightVector());
+		});
+		FSimpleValidation::RegisterGaitMode(TEXT("Live"), [AnimInstance = Instance.Get(), LastMaxGaitSpeeds = (const FSimpleGaitSpeed*)nullptr](const FSimpleGaitInput& Input) mutable
+		{
+			// Only copy the speeds when the table changes, otherwise the copy dominates the timing
+			if (LastMaxGaitSpeeds != Input.MaxGaitSpeeds)
+			{
+				AnimInstance->MaxGaitSpeeds = *Input.MaxGaitSpeeds;
+				LastMaxGaitSpeeds = Input.MaxGaitSpeeds;
+			}
+			AnimInstance->Speed = Input.Speed;
+			AnimInstance->bHasAcceleration = Input.bHasAcceleration;
+			AnimInstance->bIsStrolling = Input.bIsStrolling;
+			AnimInstance->bIsWalking = Input.bIsWalking;
+			AnimInstance->bIsSprinting = Input.bIsSprinting;
+			AnimInstance->bWantsStrolling = Input.bWantsStrolling;
+			AnimInstance->bWantsWalking = Input.bWantsWalking;
+			AnimInstance->bWantsSprinting = Input.bWantsSprinting;
+			AnimInstance->StopGait = Input.PrevStopGait;
+
+			AnimInstance->NativeThreadSafeUpdateGaitMode(0.f);
+
+			FSimpleGaitResult Result;
+			Result.Gait = AnimInstance->Gait;
+			Result.StartGait = AnimInstance->StartGait;
+			Result.GaitSpeed = AnimInstance->GaitSpeed;
+			Result.StopGait = AnimInstance->StopGait;
+			return Result;
+		});
+	}
+}
+
+void FSimpleValidation::RegisterSelectCardinal(FName Name, FSimpleSelectCardinalFunc Func)
+{
+	SimpleValidation::GetCandidates().SelectCardinal.Add(Name, MoveTemp(Func));
+}
+
+void FSimpleValidation::RegisterSelectBasicCardinal(FName Name, FSimpleSelectBasicCardinalFunc Func)
+{
+	SimpleValidation::GetCandidates().SelectBasicCardinal.Add(Name, MoveTemp(Func));
+}
+
+void FSimpleValidation::RegisterCalculateDirection(FName Name, FSimpleCalculateDirectionFunc Func)
+{
+	SimpleValidation::GetCandidates().CalculateDirection.Add(Name, MoveTemp(Func));
+}
+
+void FSimpleValidation::RegisterGaitMode(FName Name, FSimpleGaitModeFunc Func)
+{
+	SimpleValidation::GetCandidates().GaitMode.Add(Name, MoveTemp(Func));
+}
+
+void FSimpleValidation::UnregisterCandidate(FName Name)
+{
+	SimpleValidation::FCandidates& Candidates = SimpleValidation::GetCandidates();
+	Candidates.SelectCardinal.Remove(Name);
+	Candidates.SelectBasicCardinal.Remove(Name);
+	Candidates.CalculateDirection.Remove(Name);
+	Candidates.GaitMode.Remove(Name);
+}
+
+bool FSimpleValidation::RunValidation(float AngleStep, const FString& Filter)
+{
+	using namespace SimpleValidation;
+
+	check(IsInGameThread());
+
+	AngleStep = FMath::Clamp(AngleStep, 0.001f, 45.f);
+	RegisterLiveCandidates();
+
+	const TArray<float> Angles = BuildAngles(AngleStep);
+	UE_LOG(LogSimpleValidation, Display, TEXT("Validating against reference with %d angles (step %.3f)"), Angles.Num(), AngleStep);
+
+	bool bPassed = true;
+	bPassed &= ValidateSelectCardinal(Angles, Filter);
+	bPassed &= ValidateSelectBasicCardinal(Angles, Filter);
+	bPassed &= ValidateCalculateDirection(AngleStep, Filter);
+	bPassed &= ValidateGaitMode(Filter);
+
+	if (bPassed)
+	{
+		UE_LOG(LogSimpleValidation, Display, TEXT("All candidates match the reference"));
+	}
+	else
+	{
+		UE_LOG(LogSimpleValidation, Error, TEXT("One or more candidates do not match the reference"));
+	}
+	return bPassed;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimpleValidationTest, "SimpleLocomotion.Validation.Reference",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSimpleValidationTest::RunTest(const FString& Parameters)
+{
+	// Mismatch details are logged as warnings by the sweep and captured by the test
+	return TestTrue(TEXT("All candidates match the reference"), FSimpleValidation::RunValidation());
+}
+
+#endif
+
+#endif
@@ -6,8 +6,11 @@
 #include "SimpleTags.h"
 #include "SimpleTypes.h"
 #include "Components/ActorComponent.h"
+#include "GameFramework/Actor.h"
+#include <atomic>
 #include "SimpleAnimComponent.generated.h"
 
+DECLARE_MULTICAST_DELEGATE(FSimpleOnNetRoleChanged);
 
 UCLASS(Abstract, ClassGroup=(Custom))
 class SIMPLELOCOMOTION_API USimpleAnimComponent : public UActorComponent
@@ -24,6 +27,17 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category=Editor)
 	TArray<FName> ImportantEditorCategories = {};
 #endif
+
+	/**
+	 * Produce the snapshot at the end of the movement component's tick instead of during NativeUpdateAnimation()
+	 * The snapshot is gathered while the movement data is still hot and the anim instance only picks up the result
+	 * @see GetSimpleMovementTickComponent()
+	 */
+	UPROPERTY(EditDefaultsOnly, Category=Simple)
+	bool bProduceSnapshotInMovementTick = false;
+
+	/** Broadcast by NotifySimpleNetRoleChanged(), USimpleAnimInstance refreshes its cached role and local control */
+	FSimpleOnNetRoleChanged OnSimpleNetRoleChanged;
 	
 public:
 	USimpleAnimComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
@@ -31,10 +45,86 @@ public:
 	virtual void OnRegister() override;
 	virtual void InitializeComponent() override;
 	virtual void PostLoad() override;
+	virtual void BeginPlay() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 protected:
 	/** This is where you cast the owner and cache it along with any other references */
 	virtual void SetUpdatedCharacter() {}
+
+public:
+	/** The component whose tick moves the owner, the snapshot is produced after it when bProduceSnapshotInMovementTick */
+	virtual UActorComponent* GetSimpleMovementTickComponent() const;
+
+	bool WantsProduceSnapshotInMovementTick() const { return bProduceSnapshotInMovementTick; }
+
+	/**
+	 * The snapshot produced during this frame's movement tick, or nullptr if there isn't one yet
+	 * The returned slot is not written again until the next frame's tick, so the reader may complete it in place
+	 */
+	FSimpleLocomotionSnapshot* GetPublishedSimpleSnapshot();
+
+	/** Gather using the bound gather function if any, otherwise GatherSimpleSnapshot() */
+	void ProduceSimpleSnapshot(FSimpleLocomotionSnapshot& Snapshot) const
+	{
+		if (SimpleGatherFunction)
+		{
+			SimpleGatherFunction(this, Snapshot);
+		}
+		else
+		{
+			GatherSimpleSnapshot(Snapshot);
+		}
+	}
+
+protected:
+	/** Double buffer written by TickComponent() */
+	FSimpleLocomotionSnapshot SnapshotBuffers[2];
+
+	/** (GFrameCounter << 1) | BufferIndex of the last published snapshot */
+	std::atomic<uint64> PublishedSnapshot { MAX_uint64 };
+
+public:
+	/**
+	 * Gather every input USimpleAnimInstance requires for this frame
+	 * Called on the game thread by USimpleAnimInstance::NativeUpdateAnimation(), or TickComponent() if bProduceSnapshotInMovementTick
+	 */
+	virtual void GatherSimpleSnapshot(FSimpleLocomotionSnapshot& Snapshot) const;
+
+	/**
+	 * The only implementation of the gather, shared by GatherSimpleSnapshot() and TSimpleAnimComponentBinding
+	 * Source provides the USimpleAnimComponent getters. Subclasses that mark their getters final can override
+	 * GatherSimpleSnapshot() to call this with their own type, which allows every getter to be devirtualized and inlined
+	 */
+	template<typename SourceT>
+	static void GatherSimpleSnapshotFor(const SourceT& Source, const AActor& Owner, FSimpleLocomotionSnapshot& Snapshot);
+
+	/** Signature of a compile-time generated gather, see TSimpleAnimComponentBinding */
+	using FSimpleGatherFunction = void(*)(const USimpleAnimComponent* Component, FSimpleLocomotionSnapshot& Snapshot);
+
+	/** If bound, USimpleAnimInstance calls this instead of GatherSimpleSnapshot() */
+	FSimpleGatherFunction GetSimpleGatherFunction() const { return SimpleGatherFunction; }
+
+	/** Owner cached by TSimpleAnimComponentBinding::Bind() */
+	UObject* GetSimpleBoundOwner() const { return SimpleBoundOwner; }
+
+	/** Movement cached by TSimpleAnimComponentBinding::Bind() */
+	UObject* GetSimpleBoundMovement() const { return SimpleBoundMovement; }
+
+	/**
+	 * Use a compile-time generated gather function, typically called from SetUpdatedCharacter()
+	 * Passing nullptr for any parameter reverts to GatherSimpleSnapshot()
+	 */
+	void SetSimpleGatherFunction(FSimpleGatherFunction InGatherFunction, UObject* InOwner, UObject* InMovement);
+
+protected:
+	UPROPERTY(Transient, DuplicateTransient)
+	TObjectPtr<UObject> SimpleBoundOwner = nullptr;
+
+	UPROPERTY(Transient, DuplicateTransient)
+	TObjectPtr<UObject> SimpleBoundMovement = nullptr;
+
+	FSimpleGatherFunction SimpleGatherFunction = nullptr;
 	
 public:
 	/** A mode pertaining to your specific project, representing the state of the character, e.g. in combat */
@@ -66,6 +156,12 @@ public:
 	 */
 	virtual FSimpleGaitSpeed GetSimpleMaxGaitSpeeds() const PURE_VIRTUAL(, return {};);
 	
+	/** UCharacterMovementComponent::GetMaxBrakingDeceleration(), used to predict stops */
+	virtual float GetSimpleBrakingDeceleration() const { return 0.f; }
+
+	/** UCharacterMovementComponent braking friction multiplied by BrakingFrictionFactor, used to predict stops */
+	virtual float GetSimpleBrakingFriction() const { return 0.f; }
+	
 	/** Change the rate at which the additive lean occurs optionally based on stance, gait, or other state */
 	virtual float GetSimpleLeanRate() const { return 3.75f; }
 	
@@ -75,6 +171,15 @@ public:
 	/** Used with TurnInPlace systems where usually a mesh offset is applied */
 	virtual float GetSimpleRootYawOffset() const { return 0.f; }
 
+	/**
+	 * UCapsuleComponent::GetScaledCapsuleHalfHeight()
+	 * Distance from the actor location to its base, subtracted from ground probe hits to produce GroundDistance
+	 */
+	virtual float GetSimpleGroundProbeHalfHeight() const { return 0.f; }
+
+	/** Channel used to find the ground beneath the owner while in air */
+	virtual ECollisionChannel GetSimpleGroundProbeChannel() const { return ECC_Visibility; }
+
 	/** UCharacterMovementComponent::GetGravityZ()  */
 	virtual float GetSimpleGravityZ() const { return 1.f; }
 
@@ -132,11 +237,25 @@ public:
 	/** Optional to pause anim system until fully initialized the character */
 	virtual bool GetSimpleOwnerHasInitialized() const PURE_VIRTUAL(, return true;)
 	
-	/** AActor::GetLocalRole() */
+	/** AActor::GetLocalRole(), queried by USimpleAnimInstance when the controller or role changes rather than every frame */
 	virtual ENetRole GetSimpleLocalRole() const PURE_VIRTUAL(, return ROLE_None;)
 
-	/** ACharacter::IsLocallyControlled() */
+	/** ACharacter::IsLocallyControlled(), queried by USimpleAnimInstance when the controller or role changes rather than every frame */
 	virtual bool GetSimpleIsLocallyControlled() const PURE_VIRTUAL(, return false;)
+
+public:
+	/**
+	 * Call when the owner's role changes without the controller changing, e.g. from your actor:
+	 *
+	 * virtual void PostNetReceiveRole() override
+	 * {
+	 *     Super::PostNetReceiveRole();
+	 *     SimpleAnimComponent->NotifySimpleNetRoleChanged();
+	 * }
+	 */
+	void NotifySimpleNetRoleChanged() const { OnSimpleNetRoleChanged.Broadcast(); }
+
+protected:
 	
 	/**
 	 * Add to your actor that owns this component:
@@ -153,4 +272,51 @@ public:
 	 * (void)SimpleLandedDelegate.ExecuteIfBound(Hit);  // (void) uses the return value so IDE doesn't complain
 	 */
 	virtual FSimpleLandedSignature* GetSimpleOnLandedDelegate() { return nullptr; }
-};
\ No newline at end of file
+};
+
+template<typename SourceT>
+void USimpleAnimComponent::GatherSimpleSnapshotFor(const SourceT& Source, const AActor& Owner, FSimpleLocomotionSnapshot& Snapshot)
+{
+	Snapshot.State = Source.GetSimpleAnimState();
+
+	Snapshot.Location = Owner.GetActorLocation();
+	Snapshot.Velocity = Source.GetSimpleVelocity();
+	Snapshot.Acceleration = Source.GetSimpleAcceleration();
+	Snapshot.SetWorldQuat(Owner.GetActorQuat());
+
+	Snapshot.ControlRotation = Source.GetSimpleControlRotation();
+	Snapshot.BaseAimRotation = Source.GetSimpleBaseAimRotation();
+
+	Snapshot.MaxSpeed = Source.GetSimpleMaxSpeed();
+	Snapshot.BrakingDeceleration = Source.GetSimpleBrakingDeceleration();
+	Snapshot.BrakingFriction = Source.GetSimpleBrakingFriction();
+	Snapshot.MaxGaitSpeeds = Source.GetSimpleMaxGaitSpeeds();
+	Snapshot.LeanRate = Source.GetSimpleLeanRate();
+	Snapshot.StartLeanRate = Source.GetSimpleStartLeanRate();
+
+	Snapshot.RootYawOffset = Source.GetSimpleRootYawOffset();
+
+	Snapshot.bIsCurrentFloorWalkable = Source.IsSimpleCurrentFloorWalkable();
+	Snapshot.bIsMovingOnGround = Source.GetSimpleIsMovingOnGround();
+	Snapshot.bIsFalling = Source.GetSimpleIsFalling();
+	Snapshot.bCanJump = Source.GetSimpleCanJump();
+	Snapshot.GravityZ = Source.GetSimpleGravityZ();
+	Snapshot.bMovementIs3D = Source.GetSimpleMovementIs3D();
+	Snapshot.bMovementOnWall = Source.GetSimpleMovementOnWall();
+
+	Snapshot.bIsCrouched = Source.GetSimpleIsCrouched();
+	Snapshot.bIsProned = Source.GetSimpleIsProned();
+
+	Snapshot.bIsStrolling = Source.GetSimpleIsStrolling();
+	Snapshot.bIsWalking = Source.GetSimpleIsWalking();
+	Snapshot.bIsSprinting = Source.GetSimpleIsSprinting();
+
+	Snapshot.bWantsStrolling = Source.GetSimpleWantsStrolling();
+	Snapshot.bWantsWalking = Source.GetSimpleWantsWalking();
+	Snapshot.bWantsSprinting = Source.GetSimpleWantsSprinting();
+
+	Snapshot.bWantsLandingFrameLock = Source.WantsFrameLockOnLanding();
+	Snapshot.bIsMoveModeValid = Source.GetSimpleIsMoveModeValid();
+
+	Snapshot.bIsPlayingNetworkedRootMotionMontage = Source.IsPlayingNetworkedRootMotionMontage();
+}
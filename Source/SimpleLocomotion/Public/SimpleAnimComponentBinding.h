@@ -0,0 +1,137 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SimpleAnimComponent.h"
+#include "SimpleTags.h"
+#include "SimpleTypes.h"
+#include "GameFramework/Actor.h"
+#include "Engine/EngineTypes.h"
+
+/**
+ * Compile-time binding of USimpleAnimComponent inputs
+ * Generates a single gather function with no virtual dispatch, that USimpleAnimInstance calls through one pointer
+ *
+ * Defaults read from an ACharacter / UCharacterMovementComponent style API, hide any of them in your binding to
+ * change the source of that input. Your binding must implement GetSimpleMaxGaitSpeeds()
+ *
+ * EXAMPLE IMPLEMENTATION
+ * struct FMyAnimBinding : TSimpleAnimComponentBinding<FMyAnimBinding, AMyCharacter, UMyMovement>
+ * {
+ *		static bool GetSimpleIsSprinting(const AMyCharacter& Owner, const UMyMovement& Movement) { return Owner.IsSprinting(); }
+ *		static FSimpleGaitSpeed GetSimpleMaxGaitSpeeds(const AMyCharacter& Owner, const UMyMovement& Movement) { ... }
+ * };
+ *
+ * void UMyAnimComponent::SetUpdatedCharacter()
+ * {
+ *		AMyCharacter* Character = Cast<AMyCharacter>(GetOwner());
+ *		FMyAnimBinding::Bind(this, Character, Character ? Character->GetMyMovement() : nullptr);
+ * }
+ */
+template<typename DerivedT, typename OwnerT, typename MovementT>
+struct TSimpleAnimComponentBinding
+{
+	using FOwner = OwnerT;
+	using FMovement = MovementT;
+
+	/** Bind the generated gather function to the component, passing nullptr reverts to GatherSimpleSnapshot() */
+	static void Bind(USimpleAnimComponent* Component, OwnerT* Owner, MovementT* Movement)
+	{
+		if (Component)
+		{
+			Component->SetSimpleGatherFunction(&Gather, Owner, Movement);
+		}
+	}
+
+	/** Revert to USimpleAnimComponent::GatherSimpleSnapshot() */
+	static void Unbind(USimpleAnimComponent* Component)
+	{
+		if (Component)
+		{
+			Component->SetSimpleGatherFunction(nullptr, nullptr, nullptr);
+		}
+	}
+
+	/** Presents DerivedT's static getters as the member getters USimpleAnimComponent::GatherSimpleSnapshotFor() reads */
+	struct FSource
+	{
+		const OwnerT& Owner;
+		const MovementT& Movement;
+
+		FGameplayTag GetSimpleAnimState() const { return DerivedT::GetSimpleAnimState(Owner, Movement); }
+		FVector GetSimpleVelocity() const { return DerivedT::GetSimpleVelocity(Owner, Movement); }
+		FVector GetSimpleAcceleration() const { return DerivedT::GetSimpleAcceleration(Owner, Movement); }
+		FRotator GetSimpleControlRotation() const { return DerivedT::GetSimpleControlRotation(Owner, Movement); }
+		FRotator GetSimpleBaseAimRotation() const { return DerivedT::GetSimpleBaseAimRotation(Owner, Movement); }
+		float GetSimpleMaxSpeed() const { return DerivedT::GetSimpleMaxSpeed(Owner, Movement); }
+		float GetSimpleBrakingDeceleration() const { return DerivedT::GetSimpleBrakingDeceleration(Owner, Movement); }
+		float GetSimpleBrakingFriction() const { return DerivedT::GetSimpleBrakingFriction(Owner, Movement); }
+		FSimpleGaitSpeed GetSimpleMaxGaitSpeeds() const { return DerivedT::GetSimpleMaxGaitSpeeds(Owner, Movement); }
+		float GetSimpleLeanRate() const { return DerivedT::GetSimpleLeanRate(Owner, Movement); }
+		float GetSimpleStartLeanRate() const { return DerivedT::GetSimpleStartLeanRate(Owner, Movement); }
+		float GetSimpleRootYawOffset() const { return DerivedT::GetSimpleRootYawOffset(Owner, Movement); }
+		float GetSimpleGravityZ() const { return DerivedT::GetSimpleGravityZ(Owner, Movement); }
+		bool IsSimpleCurrentFloorWalkable() const { return DerivedT::IsSimpleCurrentFloorWalkable(Owner, Movement); }
+		bool GetSimpleIsMovingOnGround() const { return DerivedT::GetSimpleIsMovingOnGround(Owner, Movement); }
+		bool GetSimpleIsFalling() const { return DerivedT::GetSimpleIsFalling(Owner, Movement); }
+		bool GetSimpleCanJump() const { return DerivedT::GetSimpleCanJump(Owner, Movement); }
+		bool GetSimpleIsCrouched() const { return DerivedT::GetSimpleIsCrouched(Owner, Movement); }
+		bool GetSimpleIsProned() const { return DerivedT::GetSimpleIsProned(Owner, Movement); }
+		bool GetSimpleIsStrolling() const { return DerivedT::GetSimpleIsStrolling(Owner, Movement); }
+		bool GetSimpleIsWalking() const { return DerivedT::GetSimpleIsWalking(Owner, Movement); }
+		bool GetSimpleIsSprinting() const { return DerivedT::GetSimpleIsSprinting(Owner, Movement); }
+		bool GetSimpleWantsStrolling() const { return DerivedT::GetSimpleWantsStrolling(Owner, Movement); }
+		bool GetSimpleWantsWalking() const { return DerivedT::GetSimpleWantsWalking(Owner, Movement); }
+		bool GetSimpleWantsSprinting() const { return DerivedT::GetSimpleWantsSprinting(Owner, Movement); }
+		bool GetSimpleMovementIs3D() const { return DerivedT::GetSimpleMovementIs3D(Owner, Movement); }
+		bool GetSimpleMovementOnWall() const { return DerivedT::GetSimpleMovementOnWall(Owner, Movement); }
+		bool GetSimpleIsMoveModeValid() const { return DerivedT::GetSimpleIsMoveModeValid(Owner, Movement); }
+		bool WantsFrameLockOnLanding() const { return DerivedT::WantsFrameLockOnLanding(Owner, Movement); }
+		bool IsPlayingNetworkedRootMotionMontage() const { return DerivedT::IsPlayingNetworkedRootMotionMontage(Owner, Movement); }
+	};
+
+	/** The generated gather, every input is resolved at compile time against DerivedT */
+	static void Gather(const USimpleAnimComponent* Component, FSimpleLocomotionSnapshot& Snapshot)
+	{
+		// Bind() is the only typed entry point, checked in case SetSimpleGatherFunction() was called with other types
+		const OwnerT& Owner = *CastChecked<OwnerT>(Component->GetSimpleBoundOwner());
+		const MovementT& Movement = *CastChecked<MovementT>(Component->GetSimpleBoundMovement());
+
+		USimpleAnimComponent::GatherSimpleSnapshotFor(FSource { Owner, Movement }, Owner, Snapshot);
+	}
+
+	/** Defaults, hide these in DerivedT to change the source. See USimpleAnimComponent for what each represents */
+	static FGameplayTag GetSimpleAnimState(const OwnerT& Owner, const MovementT& Movement) { return FSimpleTags::Simple_State_Default; }
+	static FVector GetSimpleVelocity(const OwnerT& Owner, const MovementT& Movement) { return Owner.GetVelocity(); }
+	static FVector GetSimpleAcceleration(const OwnerT& Owner, const MovementT& Movement) { return Movement.GetCurrentAcceleration(); }
+	static FRotator GetSimpleControlRotation(const OwnerT& Owner, const MovementT& Movement) { return Owner.GetControlRotation(); }
+	static FRotator GetSimpleBaseAimRotation(const OwnerT& Owner, const MovementT& Movement) { return Owner.GetBaseAimRotation(); }
+	static float GetSimpleMaxSpeed(const OwnerT& Owner, const MovementT& Movement) { return Movement.GetMaxSpeed(); }
+	static float GetSimpleBrakingDeceleration(const OwnerT& Owner, const MovementT& Movement) { return Movement.GetMaxBrakingDeceleration(); }
+	static float GetSimpleBrakingFriction(const OwnerT& Owner, const MovementT& Movement)
+	{
+		return (Movement.bUseSeparateBrakingFriction ? Movement.BrakingFriction : Movement.GroundFriction) * FMath::Max(0.f, Movement.BrakingFrictionFactor);
+	}
+	static float GetSimpleLeanRate(const OwnerT& Owner, const MovementT& Movement) { return 3.75f; }
+	static float GetSimpleStartLeanRate(const OwnerT& Owner, const MovementT& Movement) { return 3.75f; }
+	static float GetSimpleRootYawOffset(const OwnerT& Owner, const MovementT& Movement) { return 0.f; }
+	static float GetSimpleGravityZ(const OwnerT& Owner, const MovementT& Movement) { return Movement.GetGravityZ(); }
+	static bool IsSimpleCurrentFloorWalkable(const OwnerT& Owner, const MovementT& Movement) { return Movement.CurrentFloor.IsWalkableFloor(); }
+	static bool GetSimpleIsMovingOnGround(const OwnerT& Owner, const MovementT& Movement) { return Movement.IsMovingOnGround(); }
+	static bool GetSimpleIsFalling(const OwnerT& Owner, const MovementT& Movement) { return Movement.IsFalling(); }
+	static bool GetSimpleCanJump(const OwnerT& Owner, const MovementT& Movement) { return Owner.CanJump(); }
+	static bool GetSimpleIsCrouched(const OwnerT& Owner, const MovementT& Movement) { return Owner.bIsCrouched; }
+	static bool GetSimpleIsProned(const OwnerT& Owner, const MovementT& Movement) { return false; }
+	static bool GetSimpleIsStrolling(const OwnerT& Owner, const MovementT& Movement) { return false; }
+	static bool GetSimpleIsWalking(const OwnerT& Owner, const MovementT& Movement) { return false; }
+	static bool GetSimpleIsSprinting(const OwnerT& Owner, const MovementT& Movement) { return false; }
+	static bool GetSimpleWantsStrolling(const OwnerT& Owner, const MovementT& Movement) { return false; }
+	static bool GetSimpleWantsWalking(const OwnerT& Owner, const MovementT& Movement) { return false; }
+	static bool GetSimpleWantsSprinting(const OwnerT& Owner, const MovementT& Movement) { return false; }
+	static bool GetSimpleMovementIs3D(const OwnerT& Owner, const MovementT& Movement) { return Movement.IsSwimming() || Movement.IsFlying(); }
+	static bool GetSimpleMovementOnWall(const OwnerT& Owner, const MovementT& Movement) { return false; }
+	static bool GetSimpleIsMoveModeValid(const OwnerT& Owner, const MovementT& Movement) { return Movement.MovementMode != MOVE_None; }
+	static bool WantsFrameLockOnLanding(const OwnerT& Owner, const MovementT& Movement) { return false; }
+	static bool IsPlayingNetworkedRootMotionMontage(const OwnerT& Owner, const MovementT& Movement) { return Owner.IsPlayingNetworkedRootMotionMontage(); }
+};
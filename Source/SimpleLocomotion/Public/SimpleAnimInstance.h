@@ -4,10 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "SimpleAnimInstanceBase.h"
+#include "SimpleSets.h"
 #include "SimpleTypes.h"
+#include "WorldCollision.h"
 #include "SimpleAnimInstance.generated.h"
 
 class USimpleAnimComponent;
+class USimpleLocomotionSetAsset;
+class AController;
 
 /**
  * 
@@ -31,6 +35,10 @@ public:
 	bool bOwnerHasInitialized = false;
 
 public:
+	/** Shared locomotion sets, reference the same asset from each character and layer instead of authoring the sets inline */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Settings)
+	TObjectPtr<USimpleLocomotionSetAsset> LocomotionSets = nullptr;
+
 	/** Required for LeanAngle to update. If true, NativeThreadSafeUpdateAnimation() updates LeanAngle. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings)
 	bool bWantsLeansUpdated = true;
@@ -38,11 +46,116 @@ public:
 	/** Required for StartLeanAngle to update. If true, NativeThreadSafeUpdateAnimation() updates StartLeanAngle. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings)
 	bool bWantsStartLeansUpdated = true;
+
+	/**
+	 * Time for the yaw rate that drives leaning to reach ~63% of a change, 0 disables smoothing
+	 * Smoothing is independent of update rate, so leans look the same when the anim instance is throttled
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, meta=(ClampMin="0", UIMin="0", UIMax="0.5", ForceUnits="s"))
+	float LeanSmoothingTime = 0.1f;
+
+	/** Required for GroundDistance to update. If true, asynchronous traces find the ground while in air */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings)
+	bool bWantsGroundDistanceUpdated = true;
+
+	/** Furthest distance below the owner's base to look for ground, GroundDistance is clamped to this */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, meta=(EditCondition="bWantsGroundDistanceUpdated", ClampMin="0", UIMin="0", ForceUnits="cm"))
+	float GroundProbeMaxDistance = 2000.f;
+
+	/**
+	 * Longest time between ground probes
+	 * Probes are more frequent the closer the ground is relative to vertical speed, and are deferred until near the jump apex
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, meta=(EditCondition="bWantsGroundDistanceUpdated", ClampMin="0", UIMin="0", UIMax="1", ForceUnits="s"))
+	float GroundProbeMaxInterval = 0.25f;
+	
+	/** Required for the predicted stop and pivot properties to update. If true, NativeThreadSafeUpdateAnimation() predicts them */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings)
+	bool bWantsStopAndPivotUpdated = true;
+
+	/**
+	 * Acceleration must oppose velocity by at least this much for bIsPivoting
+	 * Dot product of the acceleration and velocity directions, -1 is directly opposing
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, meta=(EditCondition="bWantsStopAndPivotUpdated", ClampMin="-1", ClampMax="0", UIMin="-1", UIMax="0"))
+	float PivotDirectionThreshold = -0.5f;
+	
+	/**
+	 * Required for turn in place. If true, NativeThreadSafeUpdateAnimation() computes RootYawOffset while idle
+	 * instead of taking it from USimpleAnimComponent::GetSimpleRootYawOffset()
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings)
+	bool bWantsTurnInPlaceUpdated = false;
+
+	/** Turn animations, a turn is requested once RootYawOffset exceeds the set's AngleTolerance */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Settings, meta=(EditCondition="bWantsTurnInPlaceUpdated"))
+	FSimpleTurnLocoSet TurnInPlaceSet;
+
+	/** RootYawOffset is clamped so the mesh never lags further behind the actor than this */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, meta=(EditCondition="bWantsTurnInPlaceUpdated", ClampMin="0", ClampMax="180", UIMin="0", UIMax="180", ForceUnits="degrees"))
+	float MaxRootYawOffset = 120.f;
+
+	/** Time for RootYawOffset to blend out once we start moving or leave the ground */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, meta=(EditCondition="bWantsTurnInPlaceUpdated", ClampMin="0", UIMin="0", UIMax="0.5", ForceUnits="s"))
+	float RootYawOffsetBlendOutTime = 0.1f;
+
+	/** Curve on turn animations holding the yaw remaining until the turn completes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, meta=(EditCondition="bWantsTurnInPlaceUpdated"))
+	FName RemainingTurnYawCurveName = TEXT("RemainingTurnYaw");
+
+	/** Curve on turn animations that is 1 while the turn is rotating the root, used to detect an active turn and correct for blending */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, meta=(EditCondition="bWantsTurnInPlaceUpdated"))
+	FName TurnYawWeightCurveName = TEXT("TurnYawWeight");
+	
+	/** StrideWarpScale is clamped to this range, stride warping looks poor far from the authored speed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, meta=(ClampMin="0", UIMin="0", UIMax="1"))
+	float MinStrideWarpScale = 0.5f;
+
+	/** StrideWarpScale is clamped to this range, stride warping looks poor far from the authored speed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, meta=(ClampMin="0", UIMin="1", UIMax="2"))
+	float MaxStrideWarpScale = 1.5f;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Settings)
 	FSimpleCardinals Cardinals;
+
+#if WITH_EDITORONLY_DATA
+	/**
+	 * If true, enabled cardinal modes that the Animation Blueprint never references are disabled when cooking
+	 * References are found when the Animation Blueprint compiles, modes selected from tags built at runtime are not found
+	 */
+	UPROPERTY(EditDefaultsOnly, Category=Settings)
+	bool bStripUnusedCardinalModesOnCook = false;
+
+	/** Simple.Mode tags the Animation Blueprint referenced when it was last compiled */
+	UPROPERTY(VisibleDefaultsOnly, Category=Settings)
+	FGameplayTagContainer ReferencedCardinalModes;
+
+	UPROPERTY()
+	bool bHasScannedCardinalModes = false;
+#endif
+
+	/** Enabled modes that were never referenced when cooked, disabled in cooked builds only, see bStripUnusedCardinalModesOnCook */
+	UPROPERTY()
+	FGameplayTagContainer CookStrippedCardinalModes;
+
+	/**
+	 * Speed must pass a GaitSpeed threshold by this much before GaitSpeed changes
+	 * Prevents GaitSpeed flickering when moving at a speed near the midpoint between two gaits
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Settings, meta=(ClampMin="0", UIMin="0", ForceUnits="cm/s"))
+	float GaitSpeedHysteresis = 0.f;
+
+	/** If set, will use this instead of LeanRate */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category=Properties)
+	float LeanRateOverride = -1.f;
+
+	/** If set, will use this instead of StartLeanRate */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category=Properties)
+	float StartLeanRateOverride = -1.f;
 	
 public:
+	// Everything below is written every update, keep it together
+
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
 	FSimpleMovement World;
 	
@@ -67,6 +180,9 @@ public:
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
 	float PrevSpeed = 0.f;
 
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
+	FVector WorldLocation = FVector::ZeroVector;
+
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
 	FVector ForwardVector = FVector::ForwardVector;
 
@@ -75,6 +191,10 @@ public:
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
 	FRotator WorldRotation = FRotator::ZeroRotator;
+
+	/** Basis for local-space and cardinal math, WorldRotation is only for presentation */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
+	FQuat WorldQuat = FQuat::Identity;
 	
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
 	FRotator PrevWorldRotation = FRotator::ZeroRotator;
@@ -100,13 +220,9 @@ public:
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
 	float StartLeanRate = 0.f;
 
-	/** If set, will use this instead of LeanRate */
-	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category=Properties)
-	float LeanRateOverride = -1.f;
-
-	/** If set, will use this instead of StartLeanRate */
-	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category=Properties)
-	float StartLeanRateOverride = -1.f;
+	/** Smoothed yaw rate (degrees per second) that LeanAngle and StartLeanAngle are scaled from */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
+	float LeanYawRate = 0.f;
 	
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
 	float LeanAngle = 0.f;
@@ -123,142 +239,252 @@ public:
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
 	float TimeToJumpApex = 0.f;
 	
+	/** Distance from the owner's base to the ground while in air, 0 when grounded. See bWantsGroundDistanceUpdated */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
 	float GroundDistance = 0.f;
-	
+
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bIsCurrentFloorWalkable = true;
+	float BrakingDeceleration = 0.f;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bIsMovingOnGround = true;
+	float BrakingFriction = 0.f;
 
+	/** Distance remaining until we come to rest while braking, 0 unless bIsStopping. See bWantsStopAndPivotUpdated */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bWasInAir = false;
-	
+	float PredictedStopDistance = 0.f;
+
+	/** Time remaining until we come to rest while braking, 0 unless bIsStopping */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
+	float PredictedStopTime = 0.f;
+
+	/** Where we will come to rest while braking, WorldLocation unless bIsStopping */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
+	FVector PredictedStopLocation = FVector::ZeroVector;
+
+	/** Locomotion angle relative to the warping cardinal's authored direction, for orientation warping. See SetWarpingSource() */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
+	float OrientationWarpAngle = 0.f;
+
+	/** Speed relative to the warping animation's authored speed, for stride warping. See SetWarpingSource() */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
+	float StrideWarpScale = 1.f;
+
+	/** Distance until acceleration reverses our velocity, 0 unless bIsPivoting */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bInAir = false;
+	float PredictedPivotDistance = 0.f;
 	
+public:
+	/**
+	 * Per-update flags, packed into contiguous bits next to the rest of the per-update state
+	 * Remain readable from Blueprint and property access by name
+	 */
+
+	// Movement
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bIsFalling = false;
+	uint8 bIsCurrentFloorWalkable : 1;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bIsJumping = false;
+	uint8 bIsMovingOnGround : 1;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bCanJump = false;
+	uint8 bWasInAir : 1;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bMovementIs3D = false;
+	uint8 bInAir : 1;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bMovementOnWall = false;
-	
+	uint8 bIsFalling : 1;
+
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bIsCrouched = false;
-	
+	uint8 bIsJumping : 1;
+
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bIsProned = false;
+	uint8 bCanJump : 1;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bIsStrolling = false;
-	
+	uint8 bMovementIs3D : 1;
+
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bIsWalking = false;
+	uint8 bMovementOnWall : 1;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bIsSprinting = false;
+	uint8 bIsMoveModeValid : 1;
 
+	// Stance and gait
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bWantsStrolling = false;
-	
+	uint8 bIsCrouched : 1;
+
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bWantsWalking = false;
+	uint8 bIsProned : 1;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bWantsSprinting = false;
+	uint8 bIsStrolling : 1;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
-	bool bIsMoveModeValid = false;
+	uint8 bIsWalking : 1;
 
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
+	uint8 bIsSprinting : 1;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
+	uint8 bWantsStrolling : 1;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
+	uint8 bWantsWalking : 1;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=Properties)
+	uint8 bWantsSprinting : 1;
+
+	// Derived each update
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	bool bHasAcceleration = false;
-	
-	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	bool bHasAcceleration2D = false;
+	uint8 bHasAcceleration : 1;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	bool bHasVelocity = false;
+	uint8 bHasAcceleration2D : 1;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	bool bHasVelocity2D = false;
-	
-public:
+	uint8 bHasVelocity : 1;
+
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	FGameplayTag Gait;
-	
+	uint8 bHasVelocity2D : 1;
+
+	/** Idle and RootYawOffset exceeds TurnInPlaceSet's AngleTolerance, play TurnInPlaceAnimation. See bWantsTurnInPlaceUpdated */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	FGameplayTag GaitSpeed;
+	uint8 bTurnInPlaceRequested : 1;
 
+	/** A turn animation is rotating the root, from the TurnYawWeight curve */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	FGameplayTag StartGait;
+	uint8 bIsTurningInPlace : 1;
 
+	/** Moving on the ground without acceleration, we are braking to a stop */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	FGameplayTag StopGait;
+	uint8 bIsStopping : 1;
 
+	/** Moving on the ground with acceleration opposing velocity. See PivotDirectionThreshold */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	FGameplayTag State;
-	
+	uint8 bIsPivoting : 1;
+
+	// Transitions, only true on the update they occurred
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	FGameplayTag Stance;
+	uint8 bStateChanged : 1;
 
-public:
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	bool bStateChanged = false;
-	
+	uint8 bStanceChanged : 1;
+
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	bool bStanceChanged = false;
-	
+	uint8 bGaitChanged : 1;
+
+	/** Became airborne this update */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	bool bGaitChanged = false;
-	
+	uint8 bEnteredAir : 1;
+
+	/** Returned to the ground this update */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	TEnumAsByte<ENetRole> LocalRole = ROLE_AutonomousProxy;
+	uint8 bLanded : 1;
 
+	// System
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	bool bDedicatedServer = false;
-	
+	uint8 bDedicatedServer : 1;
+
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
-	bool bLocallyControlled = false;
-	
+	uint8 bLocallyControlled : 1;
+
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=System)
-	bool bFirstUpdate = true;
-	
+	uint8 bFirstUpdate : 1;
+
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=System)
-	bool bWasMovingLastUpdate = false;
+	uint8 bWasMovingLastUpdate : 1;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=System)
-	bool bWasMovingLastUpdateWall = false;
+	uint8 bWasMovingLastUpdateWall : 1;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=System)
-	bool bWantsLandingFrameLock = false;
-	
+	uint8 bWantsLandingFrameLock : 1;
+
 	/** This prevents poor blending with systems such as mantling */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=System)
-	bool bLandingFrameLock = false;
+	uint8 bLandingFrameLock : 1;
 
 	/** This prevents poor blending with systems such as mantling */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=System)
-	bool bIsAnyMontagePlaying = false;
-	
+	uint8 bIsAnyMontagePlaying : 1;
+
 	/** This prevents poor blending with systems such as mantling */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=System)
-	bool bIsPlayingNetworkedRootMotionMontage = false;
+	uint8 bIsPlayingNetworkedRootMotionMontage : 1;
+
+public:
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
+	FGameplayTag Gait;
+	
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
+	FGameplayTag GaitSpeed;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
+	FGameplayTag StartGait;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
+	FGameplayTag StopGait;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
+	FGameplayTag TurnInPlaceCardinal;
+
+	/** Selected from TurnInPlaceSet when the turn was requested, held until the turn completes */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
+	TObjectPtr<UAnimSequence> TurnInPlaceAnimation = nullptr;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
+	FGameplayTag State;
+	
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
+	FGameplayTag Stance;
+
+public:
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category=State)
+	TEnumAsByte<ENetRole> LocalRole = ROLE_AutonomousProxy;
+
+	/** Driven by recorded snapshots instead of an owner, see USimpleAnimReplayCommandlet */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Transient, DuplicateTransient, Category=System)
+	bool bIsReplaying = false;
+
+	/** Montage instances that have started and not yet ended, maintained by OnMontageStarted and OnMontageEnded */
+	int32 NumActiveMontages = 0;
+
+	/** Compiled from MaxGaitSpeeds to classify GaitSpeed */
+	FSimpleGaitClassifier GaitClassifier;
+
+	/** Pending ground probe, results are read the frame after it is issued */
+	FTraceHandle GroundProbeHandle;
+	float TimeUntilGroundProbe = 0.f;
+
+	/** Cached by SetWarpingSource() so OrientationWarpAngle and StrideWarpScale don't touch the set each update */
+	FGameplayTag WarpingCardinal;
+	ESimpleCardinalType WarpingCardinalType = ESimpleCardinalType::Velocity;
+	float WarpingAuthoredAngle = 0.f;
+	float WarpingAuthoredSpeed = 0.f;
+
+	/** Only set on the class defaults, see GetSharedCardinalConfig() */
+	mutable TSharedPtr<const FSimpleCardinalConfig> SharedCardinalConfig;
+
+	/** RemainingTurnYaw curve value from the previous update, the change is applied to RootYawOffset */
+	float PrevRemainingTurnYaw = 0.f;
+
+	/** DeltaTime of the update in progress, for UpdateCardinal which is called through FSimpleCardinalUpdate */
+	float CardinalDeltaTime = 0.f;
 	
 public:
 	USimpleAnimInstance(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 	
 	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
 
+#if WITH_EDITOR
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** Cardinal configuration shared by every instance of this class, built from the class defaults on first use */
+	TSharedRef<const FSimpleCardinalConfig> GetSharedCardinalConfig() const;
+
 	bool IsLODEnabled(int32 LODThreshold) const;
 
 	virtual void NativeInitializeAnimation() override;
@@ -266,10 +492,19 @@ public:
 	virtual void NativeUpdateAnimation(float DeltaTime) override;
 	virtual void NativeThreadSafeUpdateAnimation(float DeltaTime) override;
 
+	/** Copy the inputs gathered on the game thread into the properties used by NativeThreadSafeUpdateAnimation() */
+	virtual void ApplySnapshot(const FSimpleLocomotionSnapshot& Snapshot);
+
+	/** Prepare an instance that has no owner to be driven by ApplySnapshot(), e.g. when replaying a recording */
+	void InitializeForReplay();
+
 	virtual void NativeThreadSafePreUpdateMovementProperties(float DeltaTime) {}
 	virtual void ThreadSafeUpdateLeanAngles(float DeltaTime);
 	virtual void NativeThreadSafeUpdateGaitMode(float DeltaTime);
 	virtual void NativeThreadSafeUpdateStance(float DeltaTime);
+	virtual void NativeThreadSafeUpdateStopAndPivot(float DeltaTime);
+	virtual void NativeThreadSafeUpdateTurnInPlace(float DeltaTime);
+	virtual void NativeThreadSafeUpdateWarping(float DeltaTime);
 	virtual void NativeThreadSafePostUpdateMovementProperties(float DeltaTime) {}
 	virtual void NativeThreadSafeUpdateFalling(float DeltaTime);
 	virtual void NativeThreadSafePreUpdateInAirProperties(float DeltaTime) {}
@@ -277,10 +512,36 @@ public:
 
 	virtual void NativePostEvaluateAnimation() override;
 
+public:
+	/**
+	 * Select the animation that OrientationWarpAngle and StrideWarpScale are relative to, call when the locomotion animation changes
+	 * The authored speed is read from the animation's USimpleBakedRootMotionUserData, StrideWarpScale is 1 without it
+	 */
+	UFUNCTION(BlueprintCallable, Category=Animation, meta=(BlueprintThreadSafe, GameplayTagFilter="Simple.Cardinal"))
+	void SetWarpingSource(const FSimpleStrafeLocoSet& Set, FGameplayTag Cardinal);
+
 protected:
+	void BindCardinalUpdates();
+	
 	UFUNCTION()
 	virtual void OnLanded(const FHitResult& Hit);
+
+	/** Issue and consume asynchronous ground probes while in air, updates GroundDistance */
+	virtual void UpdateGroundDistance(float DeltaTime);
+
+	/** Query the network role and local control from the component, called when the controller or role changes */
+	virtual void RefreshNetworkState();
+
+	UFUNCTION()
+	void OnPawnControllerChanged(APawn* Pawn, AController* OldController, AController* NewController);
+
+	UFUNCTION()
+	void OnSimpleMontageStarted(UAnimMontage* Montage);
+
+	UFUNCTION()
+	void OnSimpleMontageEnded(UAnimMontage* Montage, bool bInterrupted);
 	
+	/** Called on the class defaults once per mode when the shared cardinal configuration is built */
 	virtual float GetCardinalDeadZone(const FGameplayTag& CardinalMode) const;
 
 	/** CardinalMode is Simple.Mode */
@@ -0,0 +1,163 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "UObject/ObjectKey.h"
+
+#ifndef SIMPLE_ANIM_RECORDING
+#define SIMPLE_ANIM_RECORDING !UE_BUILD_SHIPPING
+#endif
+
+struct FSimpleLocomotionSnapshot;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Binary layout of a recording
+ *
+ * FSimpleAnimRecordHeader
+ * FSimpleAnimRecordFrame * NumFrames
+ * Tag table: NumTags * (uint16 Length, ANSICHAR[Length])
+ *
+ * Tags are stored as indices into the tag table so frames stay fixed-size and can be read in place from a mapped file
+ * Recordings are written in native endianness and are expected to be replayed on the same platform
+ */
+namespace SimpleAnimRecord
+{
+	static constexpr uint32 Magic = 0x534C5243;  // 'SLRC'
+	static constexpr uint32 Version = 2;
+	static constexpr int32 MaxGaitSpeeds = 6;
+	static constexpr uint16 InvalidTag = MAX_uint16;
+
+	enum EFlags : uint32
+	{
+		Flag_DedicatedServer					= 1 << 0,
+		Flag_LocallyControlled					= 1 << 1,
+		Flag_IsCurrentFloorWalkable				= 1 << 2,
+		Flag_IsMovingOnGround					= 1 << 3,
+		Flag_IsFalling							= 1 << 4,
+		Flag_CanJump							= 1 << 5,
+		Flag_MovementIs3D						= 1 << 6,
+		Flag_MovementOnWall						= 1 << 7,
+		Flag_IsCrouched							= 1 << 8,
+		Flag_IsProned							= 1 << 9,
+		Flag_IsStrolling						= 1 << 10,
+		Flag_IsWalking							= 1 << 11,
+		Flag_IsSprinting						= 1 << 12,
+		Flag_WantsStrolling						= 1 << 13,
+		Flag_WantsWalking						= 1 << 14,
+		Flag_WantsSprinting						= 1 << 15,
+		Flag_IsMoveModeValid					= 1 << 16,
+		Flag_WantsLandingFrameLock				= 1 << 17,
+		Flag_IsAnyMontagePlaying				= 1 << 18,
+		Flag_IsPlayingNetworkedRootMotionMontage	= 1 << 19,
+	};
+}
+
+struct FSimpleAnimRecordHeader
+{
+	uint32 Magic = SimpleAnimRecord::Magic;
+	uint32 Version = SimpleAnimRecord::Version;
+	uint32 FrameSize = 0;
+	uint32 NumStreams = 0;
+	uint64 NumFrames = 0;
+	uint64 TagTableOffset = 0;
+	uint32 NumTags = 0;
+	uint32 Padding = 0;
+};
+
+/** A single recorded frame for a single anim instance (stream) */
+struct FSimpleAnimRecordFrame
+{
+	uint16 StreamId = 0;
+	uint16 StateTag = SimpleAnimRecord::InvalidTag;
+	uint32 Flags = 0;
+	float DeltaTime = 0.f;
+
+	FVector3f Location = FVector3f::ZeroVector;  // Single precision, only used for predicted locations
+	FVector3f Velocity = FVector3f::ZeroVector;
+	FVector3f Acceleration = FVector3f::ZeroVector;
+	FRotator3f WorldRotation = FRotator3f::ZeroRotator;
+	FRotator3f ControlRotation = FRotator3f::ZeroRotator;
+	FRotator3f BaseAimRotation = FRotator3f::ZeroRotator;
+
+	float MaxSpeed = 0.f;
+	float LeanRate = 0.f;
+	float StartLeanRate = 0.f;
+	float RootYawOffset = 0.f;
+	float GravityZ = 0.f;
+	float BrakingDeceleration = 0.f;
+	float BrakingFriction = 0.f;
+
+	uint8 LocalRole = 0;
+	uint8 NumGaitSpeeds = 0;
+	uint16 GaitTags[SimpleAnimRecord::MaxGaitSpeeds] = {};
+	float GaitSpeeds[SimpleAnimRecord::MaxGaitSpeeds] = {};
+
+	/** Convert a gathered snapshot into a frame, TagToIndex is used to register tags into the tag table */
+	static FSimpleAnimRecordFrame FromSnapshot(uint16 InStreamId, const FSimpleLocomotionSnapshot& Snapshot, float InDeltaTime,
+		TFunctionRef<uint16(const FGameplayTag&)> TagToIndex);
+
+	/** Convert a frame back into a snapshot, Tags is the tag table the frame indexes into */
+	void ToSnapshot(FSimpleLocomotionSnapshot& Snapshot, TConstArrayView<FGameplayTag> Tags) const;
+};
+
+/**
+ * Captures the per-frame inputs of every USimpleAnimInstance into a single compact binary stream
+ * Start and stop with a.SimpleAnim.Record.Start [Filename] and a.SimpleAnim.Record.Stop
+ * Replay the result with USimpleAnimReplayCommandlet
+ */
+class SIMPLELOCOMOTION_API FSimpleAnimRecorder
+{
+public:
+	static FSimpleAnimRecorder& Get();
+	static bool IsRecording() { return bRecording; }
+
+	bool StartRecording(const FString& Filename);
+	void StopRecording();
+
+	/** Append a frame for the given anim instance, each instance is recorded to its own stream */
+	void Record(const UObject* Instance, const FSimpleLocomotionSnapshot& Snapshot, float DeltaTime);
+
+	static FString GetDefaultFilename();
+
+protected:
+	uint16 GetTagIndex(const FGameplayTag& Tag);
+
+	static bool bRecording;
+
+	FCriticalSection CriticalSection;
+	TUniquePtr<FArchive> Writer;
+	FString CurrentFilename;
+	FSimpleAnimRecordHeader Header;
+	TMap<TObjectKey<UObject>, uint16> StreamIds;
+	TMap<FGameplayTag, uint16> TagIndices;
+	TArray<FGameplayTag> Tags;
+};
+
+/**
+ * Read-only view of a recording, the frames are read directly from a memory-mapped file
+ */
+class SIMPLELOCOMOTION_API FSimpleAnimRecording
+{
+public:
+	FSimpleAnimRecording();
+	~FSimpleAnimRecording();
+
+	bool Open(const FString& Filename, FString& OutError);
+
+	const FSimpleAnimRecordHeader& GetHeader() const { return *Header; }
+	TConstArrayView<FGameplayTag> GetTags() const { return Tags; }
+
+	/** Frames for each stream, in the order they were recorded */
+	const TArray<TArray<const FSimpleAnimRecordFrame*>>& GetStreams() const { return Streams; }
+
+protected:
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	const FSimpleAnimRecordHeader* Header = nullptr;
+	TArray<FGameplayTag> Tags;
+	TArray<TArray<const FSimpleAnimRecordFrame*>> Streams;
+};
@@ -0,0 +1,25 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SimpleAnimReplayCommandlet.generated.h"
+
+/**
+ * Replays a recording made with a.SimpleAnim.Record.Start through USimpleAnimInstance without a world or pawn
+ * Every recorded stream is replicated across -instances= anim instances and stepped in parallel, which gives a
+ * reproducible worst-case throughput figure and a per-frame output stream that can be diffed between builds
+ *
+ * Usage: -run=SimpleAnimReplay -file=<Recording> [-instances=N] [-class=/Path/To/ABP.ABP_C] [-output=<File>]
+ */
+UCLASS()
+class SIMPLELOCOMOTION_API USimpleAnimReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USimpleAnimReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,83 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/AssetUserData.h"
+#include "SimpleBakedRootMotion.generated.h"
+
+class UAnimSequence;
+
+/**
+ * Root motion sampled at a fixed rate into flat tables
+ * Distance is the accumulated path length so it is monotonic even if the root doubles back, allowing a binary search
+ * Yaw is unwound so it can exceed 180 degrees
+ */
+USTRUCT(BlueprintType)
+struct SIMPLELOCOMOTION_API FSimpleBakedRootMotion
+{
+	GENERATED_BODY()
+
+	/** Seconds between samples, PlayLength / (NumSamples - 1) so the last sample is at PlayLength */
+	UPROPERTY(VisibleAnywhere, Category=Animation)
+	float SampleInterval = 0.f;
+
+	UPROPERTY(VisibleAnywhere, Category=Animation)
+	float PlayLength = 0.f;
+
+	UPROPERTY(VisibleAnywhere, Category=Animation)
+	TArray<float> Distances;
+
+	UPROPERTY(VisibleAnywhere, Category=Animation)
+	TArray<float> Yaws;
+
+	bool IsValid() const { return Distances.Num() > 1 && Distances.Num() == Yaws.Num() && SampleInterval > 0.f; }
+
+	float GetTotalDistance() const { return Distances.Num() > 0 ? Distances.Last() : 0.f; }
+	float GetTotalYaw() const { return Yaws.Num() > 0 ? Yaws.Last() : 0.f; }
+
+	/** Average speed of the root over the sequence */
+	float GetAuthoredSpeed() const { return PlayLength > 0.f ? GetTotalDistance() / PlayLength : 0.f; }
+
+	/** Time at which the root has travelled Distance, binary searches the distance table */
+	float GetTimeAtDistance(float Distance) const;
+
+	/** Distance travelled by the root at Time */
+	float GetDistanceAtTime(float Time) const;
+
+	/** Yaw accumulated by the root at Time */
+	float GetYawAtTime(float Time) const;
+
+	/** Baked root motion for the sequence, nullptr if the sequence has no USimpleBakedRootMotionUserData or it hasn't baked */
+	static const FSimpleBakedRootMotion* Find(const UAnimSequence* Sequence);
+
+#if WITH_EDITOR
+	/** Sample the root motion of Sequence at SampleRate or slightly above it */
+	void Bake(const UAnimSequence* Sequence, float SampleRate);
+#endif
+};
+
+/**
+ * Add to the Asset User Data of start, stop and turn sequences to bake their root motion when the sequence is saved or cooked
+ * Distance matching can then search the baked tables on worker threads without decompressing the root track
+ */
+UCLASS(DisplayName="Simple Baked Root Motion")
+class SIMPLELOCOMOTION_API USimpleBakedRootMotionUserData : public UAssetUserData
+{
+	GENERATED_BODY()
+
+public:
+	/** Samples per second, higher rates are more accurate and use more memory */
+	UPROPERTY(EditAnywhere, Category=Animation, meta=(ClampMin="1", UIMin="10", UIMax="120", ForceUnits="Hz"))
+	float SampleRate = 30.f;
+
+	UPROPERTY(VisibleAnywhere, Category=Animation)
+	FSimpleBakedRootMotion Baked;
+
+#if WITH_EDITOR
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	void Bake();
+#endif
+};
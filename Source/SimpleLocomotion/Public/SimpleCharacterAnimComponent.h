@@ -0,0 +1,67 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SimpleAnimComponent.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "SimpleCharacterAnimComponent.generated.h"
+
+/**
+ * Ready-made USimpleAnimComponent for ACharacter and UCharacterMovementComponent
+ * Typed pointers are cached in SetUpdatedCharacter() and the engine-backed getters are final, so the gather is devirtualized
+ * Project-specific inputs (state, gaits, stances) remain virtual for you to override
+ * Nothing is gathered until GetSimpleOwnerHasInitialized(), the movement getters assume it has
+ */
+UCLASS(Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class SIMPLELOCOMOTION_API USimpleCharacterAnimComponent : public USimpleAnimComponent
+{
+	GENERATED_BODY()
+
+protected:
+	UPROPERTY(Transient, DuplicateTransient)
+	TObjectPtr<ACharacter> Character = nullptr;
+
+	UPROPERTY(Transient, DuplicateTransient)
+	TObjectPtr<UCharacterMovementComponent> CharacterMovement = nullptr;
+
+public:
+	ACharacter* GetCharacter() const { return Character; }
+	UCharacterMovementComponent* GetCharacterMovement() const { return CharacterMovement; }
+
+protected:
+	virtual void SetUpdatedCharacter() override;
+
+public:
+	virtual void GatherSimpleSnapshot(FSimpleLocomotionSnapshot& Snapshot) const override;
+	virtual UActorComponent* GetSimpleMovementTickComponent() const override { return CharacterMovement; }
+
+public:
+	virtual FVector GetSimpleVelocity() const override final { return Character->GetVelocity(); }
+	virtual FVector GetSimpleAcceleration() const override final { return CharacterMovement->GetCurrentAcceleration(); }
+	virtual FRotator GetSimpleControlRotation() const override final { return Character->GetControlRotation(); }
+	virtual FRotator GetSimpleBaseAimRotation() const override final { return Character->GetBaseAimRotation(); }
+	virtual float GetSimpleMaxSpeed() const override final { return CharacterMovement->GetMaxSpeed(); }
+	virtual float GetSimpleBrakingDeceleration() const override final { return CharacterMovement->GetMaxBrakingDeceleration(); }
+	virtual float GetSimpleBrakingFriction() const override final;
+
+	/** Walk, Run and Sprint all use UCharacterMovementComponent::MaxWalkSpeed, override if you have custom gait speeds */
+	virtual FSimpleGaitSpeed GetSimpleMaxGaitSpeeds() const override;
+
+	virtual float GetSimpleGroundProbeHalfHeight() const override;
+	virtual ECollisionChannel GetSimpleGroundProbeChannel() const override;
+	virtual float GetSimpleGravityZ() const override final { return CharacterMovement->GetGravityZ(); }
+	virtual bool IsSimpleCurrentFloorWalkable() const override final { return CharacterMovement->CurrentFloor.IsWalkableFloor(); }
+	virtual bool GetSimpleIsMovingOnGround() const override final { return CharacterMovement->IsMovingOnGround(); }
+	virtual bool GetSimpleIsFalling() const override final { return CharacterMovement->IsFalling(); }
+	virtual bool GetSimpleCanJump() const override final { return Character->CanJump(); }
+	virtual bool GetSimpleIsCrouched() const override final { return Character->bIsCrouched; }
+	virtual bool GetSimpleMovementIs3D() const override final { return CharacterMovement->IsSwimming() || CharacterMovement->IsFlying(); }
+	virtual bool GetSimpleIsMoveModeValid() const override final { return CharacterMovement->MovementMode != MOVE_None; }
+	virtual bool IsPlayingNetworkedRootMotionMontage() const override final { return Character->IsPlayingNetworkedRootMotionMontage(); }
+	virtual bool GetSimpleOwnerHasInitialized() const override { return Character && CharacterMovement; }
+	virtual ENetRole GetSimpleLocalRole() const override final { return Character ? Character->GetLocalRole() : ROLE_None; }
+	virtual bool GetSimpleIsLocallyControlled() const override final { return Character && Character->IsLocallyControlled(); }
+};
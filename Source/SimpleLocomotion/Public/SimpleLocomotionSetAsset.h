@@ -0,0 +1,271 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Misc/ScopeRWLock.h"
+#include "SimpleSets.h"
+#include <atomic>
+#include "SimpleLocomotionSetAsset.generated.h"
+
+/** State, stance and gait that a compiled set was resolved for */
+struct FSimpleSetKey
+{
+	FSimpleSetKey(const FGameplayTag& InState, const FGameplayTag& InStance, const FGameplayTag& InGait)
+		: State(InState)
+		, Stance(InStance)
+		, Gait(InGait)
+	{}
+
+	FGameplayTag State;
+	FGameplayTag Stance;
+	FGameplayTag Gait;
+
+	bool operator==(const FSimpleSetKey& Other) const
+	{
+		return State == Other.State && Stance == Other.Stance && Gait == Other.Gait;
+	}
+
+	friend uint32 GetTypeHash(const FSimpleSetKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.State), GetTypeHash(Key.Stance)), GetTypeHash(Key.Gait));
+	}
+};
+
+/**
+ * State -> Stance -> Gait hierarchy flattened into a contiguous array of loco sets
+ * Every state, stance and gait that can be resolved, including through fallbacks, maps directly to its loco set
+ * so a lookup is a single hash instead of walking three levels of maps and fallbacks
+ * The sets are not copied, the table points into the authored hierarchy and must be recompiled whenever it changes
+ */
+template<typename T>
+struct TSimpleCompiledSetTable
+{
+	/** Each authored loco set, once, in the order they were first resolved */
+	TArray<const T*> Sets;
+
+	/** Resolved index into Sets for every reachable State/Stance/Gait */
+	TMap<FSimpleSetKey, int32> Lookup;
+
+	/** States that resolve without falling back to Simple.State.Default */
+	TSet<FGameplayTag> States;
+
+	void Reset()
+	{
+		Sets.Reset();
+		Lookup.Reset();
+		States.Reset();
+	}
+
+	/** Index into Sets, INDEX_NONE if the hierarchy has no set for these tags */
+	int32 Find(const FGameplayTag& State, const FGameplayTag& Stance, const FGameplayTag& Gait) const
+	{
+		if (const int32* Index = Lookup.Find(FSimpleSetKey(State, Stance, Gait)))
+		{
+			return *Index;
+		}
+
+		// States without a set or fallback resolve to the default state, matching ESetType::AnimState
+		if (!States.Contains(State))
+		{
+			if (const int32* Index = Lookup.Find(FSimpleSetKey(FSimpleTags::Simple_State_Default, Stance, Gait)))
+			{
+				return *Index;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	const T* Get(int32 Index) const
+	{
+		return Sets.IsValidIndex(Index) ? Sets[Index] : nullptr;
+	}
+
+	/** Flatten a State -> Stance -> Gait hierarchy */
+	template<typename TStanceSet, typename TGaitSet, typename TStateSet>
+	void Compile(const TStateSet& Source)
+	{
+		Reset();
+
+		TMap<const T*, int32> Indices;
+
+		TSet<FGameplayTag> StateTags;
+		Source.StateSets.GetKeys(StateTags);
+		for (const auto& Itr : Source.Fallbacks)
+		{
+			StateTags.Add(Itr.Key);
+		}
+
+		for (const FGameplayTag& State : StateTags)
+		{
+			const TStanceSet* StanceSet = FSimpleGetter::GetSet<TStanceSet>(State, Source.StateSets, Source.Fallbacks, ESetType::AnimState);
+			if (!StanceSet)
+			{
+				continue;
+			}
+			States.Add(State);
+
+			TSet<FGameplayTag> StanceTags;
+			StanceSet->StanceSets.GetKeys(StanceTags);
+			for (const auto& Itr : StanceSet->Fallbacks)
+			{
+				StanceTags.Add(Itr.Key);
+			}
+			// Gait tags in the defaults never resolve to a stance and are skipped below
+			for (const auto& Itr : FSimpleGetter::GetDefaultFallbacks())
+			{
+				StanceTags.Add(Itr.Key);
+			}
+
+			for (const FGameplayTag& Stance : StanceTags)
+			{
+				const TGaitSet* GaitSet = FSimpleGetter::GetSet<TGaitSet>(Stance, StanceSet->StanceSets, StanceSet->Fallbacks);
+				if (!GaitSet)
+				{
+					continue;
+				}
+
+				TSet<FGameplayTag> GaitTags;
+				GaitSet->GaitSets.GetKeys(GaitTags);
+				for (const auto& Itr : GaitSet->Fallbacks)
+				{
+					GaitTags.Add(Itr.Key);
+				}
+				for (const auto& Itr : FSimpleGetter::GetDefaultFallbacks())
+				{
+					GaitTags.Add(Itr.Key);
+				}
+
+				for (const FGameplayTag& Gait : GaitTags)
+				{
+					if (const T* LocoSet = FSimpleGetter::GetSet<T>(Gait, GaitSet->GaitSets, GaitSet->Fallbacks))
+					{
+						int32* Index = Indices.Find(LocoSet);
+						if (!Index)
+						{
+							Index = &Indices.Add(LocoSet, Sets.Add(LocoSet));
+						}
+						Lookup.Add(FSimpleSetKey(State, Stance, Gait), *Index);
+					}
+				}
+			}
+		}
+
+		Sets.Shrink();
+		Lookup.Compact();
+	}
+};
+
+/**
+ * Locomotion set hierarchies authored once and shared by every Animation Blueprint and layer that references them
+ * Only a single compiled copy is held in memory regardless of how many characters use it
+ * Lookups resolve animations while holding the read lock, sets are never handed out because an edit can reallocate them
+ *
+ * Add SimpleLocomotionSet to the Asset Manager's Primary Asset Types to Scan to chunk and stream these
+ */
+UCLASS(BlueprintType)
+class SIMPLELOCOMOTION_API USimpleLocomotionSetAsset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	/** State -> Stance -> Gait -> Strafe */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Animation)
+	FSimpleStateToStanceToStrafeGaitSet StrafeSets;
+
+	/** State -> Stance -> Gait -> Start */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Animation)
+	FSimpleStateToStanceToStartGaitSet StartSets;
+
+	/** State -> Stance -> Gait -> Turn */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Animation)
+	FSimpleStateToStanceToTurnGaitSet TurnSets;
+
+public:
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PreEditChange(FProperty* PropertyAboutToChange) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** Rebuild the lookup tables from the authored sets, game thread only, readers on worker threads wait for the swap */
+	void Compile();
+
+	/** Incremented by each Compile(), handles resolved before it are no longer valid */
+	int32 GetCompileSerial() const { return CompileSerial.load(std::memory_order_acquire); }
+
+	/** Resolve State, Stance and Gait once, then pass the handle around instead of the set */
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter,Handle", GameplayTagFilter="Simple.State,Simple.Stance,Simple.Gait"))
+	FSimpleLocoSetHandle GetSetHandle(ESimpleLocoSetType Type, FGameplayTag State, FGameplayTag Stance, FGameplayTag Gait) const;
+
+	/** Animation for the cardinal from the set the handle references */
+	UAnimSequence* GetAnimation(const FSimpleLocoSetHandle& Handle, const FGameplayTag& CardinalTag) const;
+
+	/** Every animation the Mode of the set the handle references uses, false if the handle is invalid */
+	bool GetAnimations(const FSimpleLocoSetHandle& Handle, FSimpleLocoSetAnimations& OutAnimations) const;
+
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter", GameplayTagFilter="Simple.State,Simple.Stance,Simple.Gait,Simple.Cardinal"))
+	UAnimSequence* GetStrafeAnimation(FGameplayTag State, FGameplayTag Stance, FGameplayTag Gait, FGameplayTag Cardinal) const;
+
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter", GameplayTagFilter="Simple.State,Simple.Stance,Simple.Gait,Simple.Cardinal"))
+	UAnimSequence* GetStartAnimation(FGameplayTag State, FGameplayTag Stance, FGameplayTag Gait, FGameplayTag Cardinal) const;
+
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter", GameplayTagFilter="Simple.State,Simple.Stance,Simple.Gait,Simple.Cardinal"))
+	UAnimSequence* GetTurnAnimation(FGameplayTag State, FGameplayTag Stance, FGameplayTag Gait, FGameplayTag Cardinal) const;
+
+protected:
+	/**
+	 * Sets point into StrafeSets, StartSets and TurnSets, which an edit can reallocate
+	 * Call with CompiledLock held and finish with the set before releasing it
+	 */
+	const FSimpleStrafeLocoSet* FindStrafeSet(const FGameplayTag& State, const FGameplayTag& Stance, const FGameplayTag& Gait) const
+	{
+		return CompiledStrafe.Get(CompiledStrafe.Find(State, Stance, Gait));
+	}
+
+	const FSimpleStartLocoSet* FindStartSet(const FGameplayTag& State, const FGameplayTag& Stance, const FGameplayTag& Gait) const
+	{
+		return CompiledStart.Get(CompiledStart.Find(State, Stance, Gait));
+	}
+
+	const FSimpleTurnLocoSet* FindTurnSet(const FGameplayTag& State, const FGameplayTag& Stance, const FGameplayTag& Gait) const
+	{
+		return CompiledTurn.Get(CompiledTurn.Find(State, Stance, Gait));
+	}
+
+	const FSimpleStrafeLocoSet* GetStrafeSet(const FSimpleLocoSetHandle& Handle) const
+	{
+		return IsHandleCurrent(Handle, ESimpleLocoSetType::Strafe) ? CompiledStrafe.Get(Handle.Index) : nullptr;
+	}
+
+	const FSimpleStartLocoSet* GetStartSet(const FSimpleLocoSetHandle& Handle) const
+	{
+		return IsHandleCurrent(Handle, ESimpleLocoSetType::Start) ? CompiledStart.Get(Handle.Index) : nullptr;
+	}
+
+	const FSimpleTurnLocoSet* GetTurnSet(const FSimpleLocoSetHandle& Handle) const
+	{
+		return IsHandleCurrent(Handle, ESimpleLocoSetType::Turn) ? CompiledTurn.Get(Handle.Index) : nullptr;
+	}
+
+	/** Handle was resolved from this asset for Type since it was last compiled, call with CompiledLock held */
+	bool IsHandleCurrent(const FSimpleLocoSetHandle& Handle, ESimpleLocoSetType Type) const
+	{
+		return Handle.Type == Type && Handle.Asset.Get() == this && Handle.Index != INDEX_NONE &&
+			Handle.Serial == CompileSerial.load(std::memory_order_relaxed);
+	}
+
+	std::atomic<int32> CompileSerial { 0 };
+
+	/** Held for reading by every lookup and for writing while Compile() replaces the tables */
+	mutable FRWLock CompiledLock;
+
+	TSimpleCompiledSetTable<FSimpleStrafeLocoSet> CompiledStrafe;
+	TSimpleCompiledSetTable<FSimpleStartLocoSet> CompiledStart;
+	TSimpleCompiledSetTable<FSimpleTurnLocoSet> CompiledTurn;
+};
\ No newline at end of file
@@ -11,14 +11,27 @@
 class UAnimSequence;
 class UAnimMontage;
 class UBlendSpace;
+class USimpleLocomotionSetAsset;
+struct FSimpleBakedRootMotion;
 enum class ESimpleCardinalType : uint8;
 
+DECLARE_DELEGATE_OneParam(FSimpleLocoSetPrefetch, const struct FSimpleLocoSetAnimations&);
+
 enum class ESetType : uint8
 {
 	None,
 	AnimState,
 };
 
+/** Which compiled table of a USimpleLocomotionSetAsset a handle indexes */
+UENUM(BlueprintType)
+enum class ESimpleLocoSetType : uint8
+{
+	Strafe,
+	Start,
+	Turn,
+};
+
 /**
  * Custom FGameplayTagContainer that maintains order
  */
@@ -63,6 +76,19 @@ protected:
 /** Getter for Simple Animation Sets */
 struct SIMPLELOCOMOTION_API FSimpleGetter
 {
+	/** Built-in gait and stance fallbacks, sets only store the fallbacks that override these */
+	static const TMap<FGameplayTag, FSimpleGameplayTagArray>& GetDefaultFallbacks();
+
+	/** Fallbacks for KeyTag, the set's own override if it has one otherwise the default */
+	static const FSimpleGameplayTagArray* FindFallback(const FGameplayTag& KeyTag, const TMap<FGameplayTag, FSimpleGameplayTagArray>& Fallbacks)
+	{
+		if (const FSimpleGameplayTagArray* Fallback = FindFallback(KeyTag, Fallbacks))
+		{
+			return Fallback;
+		}
+		return GetDefaultFallbacks().Find(KeyTag);
+	}
+
 	static UAnimSequence* GetAnim(const FGameplayTag& KeyTag, const TMap<FGameplayTag, TObjectPtr<UAnimSequence>>& Anims,
 		const TMap<FGameplayTag, FSimpleGameplayTagArray>& Fallbacks, ESetType SetType = ESetType::None)
 	{
@@ -73,7 +99,7 @@ struct SIMPLELOCOMOTION_API FSimpleGetter
 		}
 
 		// Otherwise fallback to the closest available
-		if (const FSimpleGameplayTagArray* Fallback = Fallbacks.Find(KeyTag))
+		if (const FSimpleGameplayTagArray* Fallback = FindFallback(KeyTag, Fallbacks))
 		{
 			for (const FGameplayTag& FallbackTag : Fallback->GetGameplayTagArray())
 			{
@@ -108,7 +134,7 @@ struct SIMPLELOCOMOTION_API FSimpleGetter
 		}
 
 		// Otherwise fallback to the closest available
-		if (const FSimpleGameplayTagArray* Fallback = Fallbacks.Find(KeyTag))
+		if (const FSimpleGameplayTagArray* Fallback = FindFallback(KeyTag, Fallbacks))
 		{
 			for (const FGameplayTag& FallbackTag : Fallback->GetGameplayTagArray())
 			{
@@ -440,6 +466,9 @@ struct SIMPLELOCOMOTION_API FSimpleStartLocoSet
 	}
 
 	UAnimSequence* GetAnimation(const FGameplayTag& CardinalTag) const;
+
+	/** Baked root motion for the cardinal's animation, nullptr unless it has USimpleBakedRootMotionUserData */
+	const FSimpleBakedRootMotion* GetBakedRootMotion(const FGameplayTag& CardinalTag) const;
 };
 
 /**
@@ -529,6 +558,9 @@ struct SIMPLELOCOMOTION_API FSimpleTurnLocoSet
 	}
 
 	UAnimSequence* GetAnimation(const FGameplayTag& CardinalTag) const;
+
+	/** Baked root motion for the cardinal's animation, nullptr unless it has USimpleBakedRootMotionUserData */
+	const FSimpleBakedRootMotion* GetBakedRootMotion(const FGameplayTag& CardinalTag) const;
 };
 
 /** Container for transition animations */
@@ -568,7 +600,10 @@ struct SIMPLELOCOMOTION_API FSimpleStrafeGaitSet
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Gait", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleStrafeLocoSet> GaitSets;
 
-	/** If requested Gait is not available, fallback to the next match. Order represents priority */
+	/**
+	 * If requested Gait is not available, fallback to the next match. Order represents priority
+	 * Overrides FSimpleGetter::GetDefaultFallbacks(), add a gait with no fallbacks to disable its default
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Gait", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleGameplayTagArray> Fallbacks;
 
@@ -590,7 +625,10 @@ struct SIMPLELOCOMOTION_API FSimpleStartGaitSet
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Gait", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleStartLocoSet> GaitSets;
 
-	/** If requested Gait is not available, fallback to the next match. Order represents priority */
+	/**
+	 * If requested Gait is not available, fallback to the next match. Order represents priority
+	 * Overrides FSimpleGetter::GetDefaultFallbacks(), add a gait with no fallbacks to disable its default
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Gait", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleGameplayTagArray> Fallbacks;
 
@@ -612,7 +650,10 @@ struct SIMPLELOCOMOTION_API FSimpleTurnGaitSet
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Gait", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleTurnLocoSet> GaitSets;
 
-	/** If requested Gait is not available, fallback to the next match. Order represents priority */
+	/**
+	 * If requested Gait is not available, fallback to the next match. Order represents priority
+	 * Overrides FSimpleGetter::GetDefaultFallbacks(), add a gait with no fallbacks to disable its default
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Gait", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleGameplayTagArray> Fallbacks;
 
@@ -635,7 +676,10 @@ struct SIMPLELOCOMOTION_API FSimpleStanceSet
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Stance", ForceInlineRow))
 	TMap<FGameplayTag, TObjectPtr<UAnimSequence>> Animations;
 
-	/** If requested Stance is not available, fallback to the next match. Order represents priority */
+	/**
+	 * If requested Stance is not available, fallback to the next match. Order represents priority
+	 * Overrides FSimpleGetter::GetDefaultFallbacks(), add a stance with no fallbacks to disable its default
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Stance", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleGameplayTagArray> Fallbacks;
 };
@@ -655,7 +699,10 @@ struct SIMPLELOCOMOTION_API FSimpleStanceToStrafeGaitSet
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Stance", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleStrafeGaitSet> StanceSets;
 
-	/** If requested Stance is not available, fallback to the next match. Order represents priority */
+	/**
+	 * If requested Stance is not available, fallback to the next match. Order represents priority
+	 * Overrides FSimpleGetter::GetDefaultFallbacks(), add a stance with no fallbacks to disable its default
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Stance", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleGameplayTagArray> Fallbacks;
 };
@@ -675,7 +722,10 @@ struct SIMPLELOCOMOTION_API FSimpleStanceToStartGaitSet
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Stance", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleStartGaitSet> StanceSets;
 
-	/** If requested Stance is not available, fallback to the next match. Order represents priority */
+	/**
+	 * If requested Stance is not available, fallback to the next match. Order represents priority
+	 * Overrides FSimpleGetter::GetDefaultFallbacks(), add a stance with no fallbacks to disable its default
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Stance", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleGameplayTagArray> Fallbacks;
 };
@@ -695,7 +745,10 @@ struct SIMPLELOCOMOTION_API FSimpleStanceToTurnGaitSet
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Stance", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleTurnGaitSet> StanceSets;
 
-	/** If requested Stance is not available, fallback to the next match. Order represents priority */
+	/**
+	 * If requested Stance is not available, fallback to the next match. Order represents priority
+	 * Overrides FSimpleGetter::GetDefaultFallbacks(), add a stance with no fallbacks to disable its default
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Stance", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleGameplayTagArray> Fallbacks;
 };
@@ -779,7 +832,10 @@ struct SIMPLELOCOMOTION_API FSimpleStanceToStrafeLocoSet
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Stance", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleStrafeLocoSet> StanceSets;
 
-	/** If requested Stance is not available, fallback to the next match. Order represents priority */
+	/**
+	 * If requested Stance is not available, fallback to the next match. Order represents priority
+	 * Overrides FSimpleGetter::GetDefaultFallbacks(), add a stance with no fallbacks to disable its default
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Stance", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleGameplayTagArray> Fallbacks;
 };
@@ -899,7 +955,10 @@ struct SIMPLELOCOMOTION_API FSimpleStanceToTransitionSet
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Stance", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleTransitionSet> StanceSets;
 
-	/** If requested Stance is not available, fallback to the next match. Order represents priority */
+	/**
+	 * If requested Stance is not available, fallback to the next match. Order represents priority
+	 * Overrides FSimpleGetter::GetDefaultFallbacks(), add a stance with no fallbacks to disable its default
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Animation, meta=(GameplayTagFilter="Simple.Stance", ForceInlineRow))
 	TMap<FGameplayTag, FSimpleGameplayTagArray> Fallbacks;
 };
@@ -989,6 +1048,86 @@ struct SIMPLELOCOMOTION_API FSimpleStateToStanceToTransitionSet
 	TMap<FGameplayTag, FSimpleGameplayTagArray> Fallbacks;
 };
 
+/**
+ * Every animation used by a loco set's Mode, resolved in a single pass
+ * Resolve once when entering a state rather than querying each cardinal through the set hierarchy
+ */
+USTRUCT(BlueprintType)
+struct SIMPLELOCOMOTION_API FSimpleLocoSetAnimations
+{
+	GENERATED_BODY()
+
+	static constexpr int32 MaxCardinals = 10;
+
+	/** Optional replacement for the default Prefetch(), e.g. for projects that stream animation data */
+	static FSimpleLocoSetPrefetch PrefetchOverride;
+
+	/** Mode of the set these were resolved from */
+	UPROPERTY(BlueprintReadOnly, Category=Animation)
+	FGameplayTag Mode;
+
+	UPROPERTY(BlueprintReadOnly, Category=Animation)
+	int32 Num = 0;
+
+	UPROPERTY()
+	FGameplayTag Cardinals[MaxCardinals];
+
+	UPROPERTY()
+	TObjectPtr<UAnimSequence> Animations[MaxCardinals];
+
+	void Resolve(const FSimpleStrafeLocoSet& LocoSet);
+	void Resolve(const FSimpleStartLocoSet& LocoSet);
+	void Resolve(const FSimpleTurnLocoSet& LocoSet);
+
+	/** Animation resolved for the cardinal, nullptr if the Mode doesn't use it */
+	UAnimSequence* GetAnimation(const FGameplayTag& CardinalTag) const
+	{
+		for (int32 i = 0; i < Num; i++)
+		{
+			if (Cardinals[i] == CardinalTag)
+			{
+				return Animations[i];
+			}
+		}
+		return nullptr;
+	}
+
+	/** Warm each sequence's compressed data so the first evaluation after entering a state doesn't hitch */
+	void Prefetch() const;
+};
+
+/**
+ * Lightweight reference to a loco set compiled into a USimpleLocomotionSetAsset
+ * Pass this between thread-safe functions instead of set structs, which Blueprint copies by value
+ * Invalidated if the asset is recompiled, e.g. when edited
+ */
+USTRUCT(BlueprintType)
+struct SIMPLELOCOMOTION_API FSimpleLocoSetHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<USimpleLocomotionSetAsset> Asset = nullptr;
+
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+
+	/** USimpleLocomotionSetAsset::GetCompileSerial() when the handle was resolved */
+	UPROPERTY()
+	int32 Serial = 0;
+
+	UPROPERTY()
+	ESimpleLocoSetType Type = ESimpleLocoSetType::Strafe;
+
+	bool IsValid() const;
+
+	/** Animation for the cardinal from the set this handle references, nullptr if the handle is invalid */
+	UAnimSequence* GetAnimation(const FGameplayTag& CardinalTag) const;
+
+	/** Every animation the referenced set's Mode uses, false if the handle is invalid */
+	bool GetAnimations(FSimpleLocoSetAnimations& OutAnimations) const;
+};
+
 /**
  * Blueprint Getter for Simple Animation Sets
  */
@@ -1016,6 +1155,89 @@ public:
 		return Set.GetAnimation(Cardinal);
 	}
 
+	/** Resolve a handle from USimpleLocomotionSetAsset to the cardinal's animation without copying the set */
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter,Handle", GameplayTagFilter="Simple.Cardinal"))
+	static UAnimSequence* SimpleLocoSetHandle(const FSimpleLocoSetHandle& Handle, FGameplayTag Cardinal)
+	{
+		return Handle.GetAnimation(Cardinal);
+	}
+
+	/** Every animation the referenced set's Mode uses, see PrefetchSimpleLocoSetAnimations to warm them */
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter,Handle,All,Bulk"))
+	static FSimpleLocoSetAnimations SimpleLocoSetHandleAnimations(const FSimpleLocoSetHandle& Handle)
+	{
+		FSimpleLocoSetAnimations Animations;
+		Handle.GetAnimations(Animations);
+		return Animations;
+	}
+
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter,All,Bulk", GameplayTagFilter="Simple.Gait"))
+	static FSimpleLocoSetAnimations SimpleStrafeGaitSetAnimations(const FSimpleStrafeGaitSet& Set, FGameplayTag Gait)
+	{
+		return ResolveAnimations(FSimpleGetter::GetSet<FSimpleStrafeLocoSet>(Gait, Set.GaitSets, Set.Fallbacks));
+	}
+
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter,All,Bulk", GameplayTagFilter="Simple.Gait"))
+	static FSimpleLocoSetAnimations SimpleStartGaitSetAnimations(const FSimpleStartGaitSet& Set, FGameplayTag Gait)
+	{
+		return ResolveAnimations(FSimpleGetter::GetSet<FSimpleStartLocoSet>(Gait, Set.GaitSets, Set.Fallbacks));
+	}
+
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter,All,Bulk", GameplayTagFilter="Simple.Gait"))
+	static FSimpleLocoSetAnimations SimpleTurnGaitSetAnimations(const FSimpleTurnGaitSet& Set, FGameplayTag Gait)
+	{
+		return ResolveAnimations(FSimpleGetter::GetSet<FSimpleTurnLocoSet>(Gait, Set.GaitSets, Set.Fallbacks));
+	}
+
+	/** Use with the getters that return a loco set, e.g. SimpleStateToStanceToStrafeGaitSet */
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter,All,Bulk"))
+	static FSimpleLocoSetAnimations SimpleStrafeLocoSetAnimations(const FSimpleStrafeLocoSet& Set)
+	{
+		return ResolveAnimations(&Set);
+	}
+
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter,All,Bulk"))
+	static FSimpleLocoSetAnimations SimpleStartLocoSetAnimations(const FSimpleStartLocoSet& Set)
+	{
+		return ResolveAnimations(&Set);
+	}
+
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter,All,Bulk"))
+	static FSimpleLocoSetAnimations SimpleTurnLocoSetAnimations(const FSimpleTurnLocoSet& Set)
+	{
+		return ResolveAnimations(&Set);
+	}
+
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter", GameplayTagFilter="Simple.Cardinal"))
+	static UAnimSequence* SimpleLocoSetAnimations(const FSimpleLocoSetAnimations& Animations, FGameplayTag Cardinal)
+	{
+		return Animations.GetAnimation(Cardinal);
+	}
+
+	/** Warm the compressed data of every resolved animation, call once on state entry rather than from a getter */
+	UFUNCTION(BlueprintCallable, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Prefetch,Warm,Bulk"))
+	static void PrefetchSimpleLocoSetAnimations(const FSimpleLocoSetAnimations& Animations)
+	{
+		Animations.Prefetch();
+	}
+
+	template<typename T>
+	static FSimpleLocoSetAnimations ResolveAnimations(const T* LocoSet)
+	{
+		FSimpleLocoSetAnimations Animations;
+		if (LocoSet)
+		{
+			Animations.Resolve(*LocoSet);
+		}
+		return Animations;
+	}
+
+	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, DisplayName="Is Valid (Simple Loco Set Handle)"))
+	static bool IsSimpleLocoSetHandleValid(const FSimpleLocoSetHandle& Handle)
+	{
+		return Handle.IsValid();
+	}
+
 	UFUNCTION(BlueprintPure, Category=SimpleLocomotion, meta=(BlueprintThreadSafe, Keywords="Get,Getter", GameplayTagFilter="Simple.Gait,Simple.Cardinal"))
 	static UAnimSequence* SimpleStrafeGaitSet(const FSimpleStrafeGaitSet& Set, FGameplayTag Gait, FGameplayTag Cardinal)
 	{
@@ -54,6 +54,15 @@ public:
 	static FGameplayTag GetSimpleCardinalForTag(const FSimpleCardinals& Cardinals, FGameplayTag CardinalMode,
 		ESimpleCardinalType CardinalType, bool bOnWall = false);
 
+	/** @return Every cardinal and history tracked for the Simple.Mode */
+	UFUNCTION(BlueprintPure, Category=Animation, meta=(BlueprintThreadSafe, GameplayTagFilter="Simple.Mode"))
+	static FSimpleCardinal GetSimpleCardinalResult(const FSimpleCardinals& Cardinals, FGameplayTag CardinalMode);
+
+	/** @return Previous cardinal, time in cardinal, flip count and the bChanged/bFlipped bits for the Simple.Mode */
+	UFUNCTION(BlueprintPure, Category=Animation, meta=(BlueprintThreadSafe, GameplayTagFilter="Simple.Mode"))
+	static FSimpleCardinalHistory GetSimpleCardinalHistory(const FSimpleCardinals& Cardinals, FGameplayTag CardinalMode,
+		ESimpleCardinalType CardinalType, bool bOnWall = false);
+
 	/**
 	 * Commonly used for splitting a float angle into cardinal sections, e.g. 90.0f becomes Right - Takes a Simple.Mode and outputs Simple.Cardinal
 	 * @param CardinalMode - The Simple.Mode to use for the cardinal direction
@@ -78,6 +87,10 @@ public:
 	UFUNCTION(BlueprintPure, Category=Animation, meta=(BlueprintThreadSafe, GameplayTagFilter="Simple.Mode"))
 	static FGameplayTag SelectBasicCardinalFromAngle(const FGameplayTag& CardinalMode, float Angle);
 	
+	/** Direction of movement an animation for the Simple.Cardinal is authored to, e.g. Simple.Cardinal.Forward.Right is 45.0f */
+	UFUNCTION(BlueprintPure, Category=Animation, meta=(BlueprintThreadSafe, GameplayTagFilter="Simple.Cardinal"))
+	static float GetSimpleCardinalAngle(const FGameplayTag& CardinalTag);
+
 	UFUNCTION(BlueprintPure, Category=Animation, meta=(BlueprintThreadSafe))
 	static FGameplayTag GetSimpleOppositeCardinal(const FGameplayTag& CardinalTag);
 
@@ -91,6 +104,38 @@ public:
 	UFUNCTION(BlueprintPure, Category=Animation, meta=(BlueprintThreadSafe))
 	static FGameplayTag GetDowngradedCardinal(const FGameplayTag& CardinalTag);
 
+	/**
+	 * Predict how far and how long it takes to brake to a stop, without simulating the braking
+	 * Matches UCharacterMovementComponent braking, which removes Friction * Velocity + Deceleration each second
+	 * @param Speed Current speed
+	 * @param BrakingDeceleration Constant deceleration, e.g. UCharacterMovementComponent::GetMaxBrakingDeceleration()
+	 * @param BrakingFriction Friction scaled by BrakingFrictionFactor
+	 * @return False if we will never stop, i.e. there is no deceleration and no friction
+	 */
+	UFUNCTION(BlueprintPure, Category=Animation, meta=(BlueprintThreadSafe))
+	static bool PredictSimpleStop(float Speed, float BrakingDeceleration, float BrakingFriction, float& StopDistance, float& StopTime);
+
+	/**
+	 * Time at which the root of Sequence has travelled Distance, from its USimpleBakedRootMotionUserData
+	 * @return False if the sequence has no baked root motion
+	 */
+	UFUNCTION(BlueprintPure, Category=Animation, meta=(BlueprintThreadSafe))
+	static bool GetSimpleBakedTimeAtDistance(const UAnimSequence* Sequence, float Distance, float& Time);
+
+	/**
+	 * Distance travelled by the root of Sequence at Time, from its USimpleBakedRootMotionUserData
+	 * @return False if the sequence has no baked root motion
+	 */
+	UFUNCTION(BlueprintPure, Category=Animation, meta=(BlueprintThreadSafe))
+	static bool GetSimpleBakedDistanceAtTime(const UAnimSequence* Sequence, float Time, float& Distance);
+
+	/**
+	 * Yaw accumulated by the root of Sequence at Time, from its USimpleBakedRootMotionUserData
+	 * @return False if the sequence has no baked root motion
+	 */
+	UFUNCTION(BlueprintPure, Category=Animation, meta=(BlueprintThreadSafe))
+	static bool GetSimpleBakedYawAtTime(const UAnimSequence* Sequence, float Time, float& Yaw);
+
 	UFUNCTION(BlueprintPure, Category=Animation, meta=(BlueprintThreadSafe))
 	static bool IsMovementTurningRight(const FVector& Acceleration, const FVector& Velocity, const FVector& ActorRightVector);
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "Engine/EngineTypes.h"
 
 #include "SimpleTypes.generated.h"
 
@@ -21,6 +22,7 @@ enum class ESimpleIsValidResult : uint8
 	NotValid,
 };
 
+/** Deprecated, only used by the deprecated FSimpleCardinals::GetCardinals() */
 UENUM(BlueprintType)
 enum class ESimpleCardinalCache : uint8
 {
@@ -140,7 +142,39 @@ struct SIMPLELOCOMOTION_API FSimpleGaitSpeed
 	UPROPERTY(BlueprintReadOnly, Category=Properties)
 	TMap<FGameplayTag, float> MaxSpeeds;
 
-	float GetMaxSpeed(const FGameplayTag& GaitTag);
+	float GetMaxSpeed(const FGameplayTag& GaitTag) const;
+
+	/** Changes whenever any gait or speed changes */
+	uint32 GetSpeedsHash() const;
+};
+
+/**
+ * Classifies a speed into the gait it is closest to, compiled from FSimpleGaitSpeed
+ * Stroll, Walk, Run and Sprint are always present in that order, additional project gaits are ordered by speed
+ * Thresholds are the midpoints between consecutive gaits and are only rebuilt when the speeds change
+ */
+struct SIMPLELOCOMOTION_API FSimpleGaitClassifier
+{
+	/** Rebuild the thresholds if the speeds have changed since the last call */
+	void Update(const FSimpleGaitSpeed& GaitSpeeds);
+
+	/**
+	 * @param Speed Speed to classify
+	 * @param CurrentGait The previous result, thresholds must be crossed by Hysteresis to leave it
+	 * @param Hysteresis Dead band either side of each threshold
+	 */
+	const FGameplayTag& Classify(float Speed, const FGameplayTag& CurrentGait, float Hysteresis = 0.f) const;
+
+	const TArray<FGameplayTag, TInlineAllocator<8>>& GetGaits() const { return Gaits; }
+
+protected:
+	TArray<FGameplayTag, TInlineAllocator<8>> Gaits;
+
+	/** Midpoints between consecutive gaits, as a running maximum so they are ascending */
+	TArray<float, TInlineAllocator<8>> Thresholds;
+
+	uint32 SpeedsHash = 0;
+	bool bBuilt = false;
 };
 
 /**
@@ -179,12 +213,204 @@ struct SIMPLELOCOMOTION_API FSimpleMovement
 		};
 	}
 
+	/** Unrotate through the quaternion directly, avoids converting the rotator again */
+	FSimpleMovement GetLocal(const FQuat& WorldQuat) const
+	{
+		return FSimpleMovement {
+			WorldQuat.UnrotateVector(Velocity), WorldQuat.UnrotateVector(Acceleration)
+		};
+	}
+
 	float GetSpeed() const
 	{
 		return Velocity.Size();
 	}
 };
 
+/**
+ * Single precision working copy of FSimpleMovement with velocity and acceleration held in vector registers
+ * Used for the per-frame locomotion math, FSimpleMovement is only produced for Blueprint via ToMovement()
+ */
+struct FSimpleMovementPacked
+{
+	VectorRegister4Float Velocity = GlobalVectorConstants::FloatZero;
+	VectorRegister4Float Acceleration = GlobalVectorConstants::FloatZero;
+
+	FSimpleMovementPacked() = default;
+	
+	FSimpleMovementPacked(const VectorRegister4Float& InVelocity, const VectorRegister4Float& InAcceleration)
+		: Velocity(InVelocity)
+		, Acceleration(InAcceleration)
+	{}
+	
+	explicit FSimpleMovementPacked(const FSimpleMovement& Movement)
+		: Velocity(Load(Movement.Velocity))
+		, Acceleration(Load(Movement.Acceleration))
+	{}
+
+	static VectorRegister4Float Load(const FVector& Vector)
+	{
+		return MakeVectorRegisterFloat(static_cast<float>(Vector.X), static_cast<float>(Vector.Y), static_cast<float>(Vector.Z), 0.f);
+	}
+
+	static VectorRegister4Float Load(const FQuat& Quat)
+	{
+		return MakeVectorRegisterFloat(static_cast<float>(Quat.X), static_cast<float>(Quat.Y), static_cast<float>(Quat.Z), static_cast<float>(Quat.W));
+	}
+
+	static FVector Store(const VectorRegister4Float& Vector)
+	{
+		FVector3f Result;
+		VectorStoreFloat3(Vector, &Result.X);
+		return FVector(Result);
+	}
+
+	FSimpleMovementPacked Get2D() const
+	{
+		const VectorRegister4Float Mask = MakeVectorRegisterFloat(1.f, 1.f, 0.f, 0.f);
+		return { VectorMultiply(Velocity, Mask), VectorMultiply(Acceleration, Mask) };
+	}
+
+	/** @param WorldQuat Loaded via Load(const FQuat&) */
+	FSimpleMovementPacked GetLocal(const VectorRegister4Float& WorldQuat) const
+	{
+		return {
+			VectorQuaternionInverseRotateVector(WorldQuat, Velocity),
+			VectorQuaternionInverseRotateVector(WorldQuat, Acceleration)
+		};
+	}
+
+	float GetSpeedSquared() const { return VectorGetComponent(VectorDot3(Velocity, Velocity), 0); }
+	float GetSpeed() const { return FMath::Sqrt(GetSpeedSquared()); }
+	float GetAccelerationSquared() const { return VectorGetComponent(VectorDot3(Acceleration, Acceleration), 0); }
+
+	FSimpleMovement ToMovement() const
+	{
+		return FSimpleMovement { Store(Velocity), Store(Acceleration) };
+	}
+};
+
+/**
+ * Everything USimpleAnimInstance gathers from USimpleAnimComponent (and the owner) on the game thread each frame
+ * Produced by USimpleAnimComponent::GatherSimpleSnapshot() and consumed by USimpleAnimInstance::ApplySnapshot()
+ * Keeping the inputs in one place allows them to be recorded and replayed without an owner, see FSimpleAnimRecorder
+ */
+struct SIMPLELOCOMOTION_API FSimpleLocomotionSnapshot
+{
+	FGameplayTag State;
+
+	FVector Location = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	FVector Acceleration = FVector::ZeroVector;
+	FVector ForwardVector = FVector::ForwardVector;
+	FVector RightVector = FVector::RightVector;
+
+	FQuat WorldQuat = FQuat::Identity;
+	FRotator WorldRotation = FRotator::ZeroRotator;
+	FRotator ControlRotation = FRotator::ZeroRotator;
+	FRotator BaseAimRotation = FRotator::ZeroRotator;
+
+	FSimpleGaitSpeed MaxGaitSpeeds = {};
+
+	float MaxSpeed = 0.f;
+	float LeanRate = 0.f;
+	float StartLeanRate = 0.f;
+	float RootYawOffset = 0.f;
+	float GravityZ = 1.f;
+	float BrakingDeceleration = 0.f;
+	float BrakingFriction = 0.f;
+
+	/** Network state and montage state are kept current by USimpleAnimInstance events, not gathered by the component */
+	TEnumAsByte<ENetRole> LocalRole = ROLE_AutonomousProxy;
+	bool bDedicatedServer = false;
+	bool bLocallyControlled = false;
+
+	bool bIsCurrentFloorWalkable = true;
+	bool bIsMovingOnGround = true;
+	bool bIsFalling = false;
+	bool bCanJump = false;
+	bool bMovementIs3D = false;
+	bool bMovementOnWall = false;
+	bool bIsCrouched = false;
+	bool bIsProned = false;
+	bool bIsStrolling = false;
+	bool bIsWalking = false;
+	bool bIsSprinting = false;
+	bool bWantsStrolling = false;
+	bool bWantsWalking = false;
+	bool bWantsSprinting = false;
+	bool bIsMoveModeValid = true;
+	bool bWantsLandingFrameLock = false;
+	bool bIsAnyMontagePlaying = false;
+	bool bIsPlayingNetworkedRootMotionMontage = false;
+
+	/** Derive the basis and rotation from a single read of the owner's rotation */
+	void SetWorldQuat(const FQuat& InWorldQuat)
+	{
+		WorldQuat = InWorldQuat;
+		ForwardVector = InWorldQuat.GetForwardVector();
+		RightVector = InWorldQuat.GetRightVector();
+		WorldRotation = InWorldQuat.Rotator();
+	}
+};
+
+/**
+ * Recent history of a single tracked cardinal direction, e.g. FSimpleCardinal::Velocity
+ * The bits are precomputed so transition rules can read a single bool and stay on the fast path
+ */
+USTRUCT(BlueprintType)
+struct SIMPLELOCOMOTION_API FSimpleCardinalHistory
+{
+	GENERATED_BODY()
+
+	static constexpr int32 NumRecent = 4;
+
+	FSimpleCardinalHistory()
+		: bChanged(false)
+		, bFlipped(false)
+	{}
+
+	/** Cardinal before the most recent change */
+	UPROPERTY(BlueprintReadOnly, Category=Properties, meta=(GameplayTagFilter="Simple.Cardinal"))
+	FGameplayTag Previous;
+
+	/** Time since the cardinal last changed */
+	UPROPERTY(BlueprintReadOnly, Category=Properties, meta=(ForceUnits="s"))
+	float TimeInCardinal = 0.f;
+
+	/** Number of changes to the opposite cardinal, e.g. Forward to Backward, since the cardinal last cleared */
+	UPROPERTY(BlueprintReadOnly, Category=Properties)
+	int32 FlipCount = 0;
+
+	/** The cardinal changed this update */
+	UPROPERTY(BlueprintReadOnly, Category=Properties)
+	uint8 bChanged : 1;
+
+	/** The cardinal changed to the opposite cardinal this update */
+	UPROPERTY(BlueprintReadOnly, Category=Properties)
+	uint8 bFlipped : 1;
+
+	/** Ring buffer of the most recent cardinals, see GetRecent() */
+	FGameplayTag Recent[NumRecent];
+	uint8 RecentHead = 0;
+
+	/** Cardinal from Index changes ago, 0 is the current cardinal */
+	const FGameplayTag& GetRecent(int32 Index) const
+	{
+		check(Index >= 0 && Index < NumRecent);
+		return Recent[(RecentHead + NumRecent - Index) % NumRecent];
+	}
+
+	void Update(const FGameplayTag& PrevCardinal, const FGameplayTag& Cardinal, float DeltaTime);
+
+	/** The cardinal was not updated this frame */
+	void ClearTransitionBits()
+	{
+		bChanged = false;
+		bFlipped = false;
+	}
+};
+
 /**
  * Represents a single Cardinal Mode (FSimpleGameplayTags "Simple.State")
  * Directional cardinal states, data, and update delegate handling
@@ -219,10 +445,51 @@ struct SIMPLELOCOMOTION_API FSimpleCardinal
 	UPROPERTY(BlueprintReadOnly, Category=Properties, meta=(GameplayTagFilter="Simple.Cardinal"))
 	FGameplayTag VelocityWall;
 
-	/** Bound in USimpleAnimInstance::NativeInitializeAnimation */
-	FSimpleCardinalUpdate UpdateDelegate;
+	UPROPERTY(BlueprintReadOnly, Category=Properties)
+	FSimpleCardinalHistory AccelerationHistory;
+
+	UPROPERTY(BlueprintReadOnly, Category=Properties)
+	FSimpleCardinalHistory VelocityHistory;
+
+	UPROPERTY(BlueprintReadOnly, Category=Properties)
+	FSimpleCardinalHistory AccelerationWallHistory;
+
+	UPROPERTY(BlueprintReadOnly, Category=Properties)
+	FSimpleCardinalHistory VelocityWallHistory;
 
 	FGameplayTag GetCardinal(ESimpleCardinalType CardinalType, bool bOnWall = false) const;
+	const FSimpleCardinalHistory& GetHistory(ESimpleCardinalType CardinalType, bool bOnWall = false) const;
+};
+
+/**
+ * Immutable configuration of the enabled cardinal modes, built once per anim instance class and shared by every instance
+ * See USimpleAnimInstance::GetSharedCardinalConfig()
+ */
+struct SIMPLELOCOMOTION_API FSimpleCardinalConfig
+{
+	struct FMode
+	{
+		FGameplayTag Mode;
+		FGameplayTagContainer Tags;
+		float DeadZone = 0.f;
+	};
+
+	/** Enabled modes only, FSimpleCardinals results are stored at the same indices */
+	TArray<FMode> Modes;
+
+	int32 IndexOfMode(const FGameplayTag& CardinalModeTag) const
+	{
+		return Modes.IndexOfByPredicate([&CardinalModeTag](const FMode& Mode) { return Mode.Mode == CardinalModeTag; });
+	}
+
+	float GetDeadZone(const FGameplayTag& CardinalModeTag) const
+	{
+		const int32 Index = IndexOfMode(CardinalModeTag);
+		return Modes.IsValidIndex(Index) ? Modes[Index].DeadZone : 0.f;
+	}
+
+	static TSharedRef<const FSimpleCardinalConfig> Build(const TMap<FGameplayTag, FSimpleCardinal>& Cardinals,
+		TFunctionRef<float(const FGameplayTag&)> GetDeadZone);
 };
 
 /**
@@ -245,7 +512,6 @@ struct SIMPLELOCOMOTION_API FSimpleCardinals
 		, VelocityWall(InVelocity3D)
 		, AccelerationWall(InAcceleration3D)
 		, bHasEverUpdated(false)
-		, bHasCachedCardinals(false)
 	{
 		ConstructDefaultCardinals();
 	}
@@ -257,13 +523,19 @@ struct SIMPLELOCOMOTION_API FSimpleCardinals
 		bool bOnWall
 		)
 		: bHasEverUpdated(false)
-		, bHasCachedCardinals(false)
 	{
 		ConstructDefaultCardinals();
-		ThreadSafeUpdate_Internal(World2D, World, WorldRotation, bOnWall);
+		ThreadSafeUpdate_Internal(World2D, World, WorldRotation.Quaternion(), bOnWall);
 	}
 
 	void ConstructDefaultCardinals(bool bEnableDefaultCardinals = true);
+
+	/**
+	 * Immutable default cardinal modes, built once on first use and copied by every constructor
+	 * The copy still allocates the map and tag containers, it only skips building and hashing the tags
+	 * Tagged property serialization writes Cardinals as a delta against these
+	 */
+	static const TMap<FGameplayTag, FSimpleCardinal>& GetDefaultCardinals(bool bEnableDefaultCardinals = true);
 	
 	static FGameplayTagContainer ConstructCardinalTags_1Way();
 	static FGameplayTagContainer ConstructCardinalTags_2Way();
@@ -281,6 +553,7 @@ struct SIMPLELOCOMOTION_API FSimpleCardinals
 	static FGameplayTagContainer ConstructCardinalTags_Turn_4Way();
 	static FGameplayTagContainer ConstructCardinalTags_Turn_8Way();
 
+	/** Changes the configuration, takes effect when the shared configuration is next built */
 	void SetCardinalEnabled(const FGameplayTag& CardinalModeTag, bool bEnabled);
 
 	UPROPERTY(BlueprintReadOnly, Category=Properties)
@@ -304,6 +577,12 @@ struct SIMPLELOCOMOTION_API FSimpleCardinals
 	 */
 	FGameplayTag GetCurrentCardinal(const FGameplayTag& CardinalModeTag, ESimpleCardinalType CardinalType, bool bOnWall = false) const;
 
+	/** Result of the Simple.Mode, every cardinal and history it tracks, empty if the mode is not enabled */
+	FSimpleCardinal GetCurrentResult(const FGameplayTag& CardinalModeTag) const;
+
+	/** History of the current cardinal based on Simple.Mode and CardinalType, empty if the mode is not enabled */
+	FSimpleCardinalHistory GetCurrentHistory(const FGameplayTag& CardinalModeTag, ESimpleCardinalType CardinalType, bool bOnWall = false) const;
+
 	FGameplayTag GetCurrentCardinal(const struct FSimpleStrafeLocoSet& LocomotionSet, bool bOnWall = false) const;
 	FGameplayTag GetCurrentCardinal(const struct FSimpleStrafeLocoSet* LocomotionSet, bool bOnWall = false) const;
 	FGameplayTag GetCurrentCardinal(const struct FSimpleStartLocoSet& LocomotionSet, bool bOnWall = false) const;
@@ -313,30 +592,55 @@ struct SIMPLELOCOMOTION_API FSimpleCardinals
 	
 	float GetDirectionAngle(ESimpleCardinalType CardinalType, bool bHorizontal = true) const;
 
-	void ThreadSafeUpdate(const FSimpleMovement& World2D, const FSimpleMovement& World, const FRotator& WorldRotation, bool bOnWall = false);
+	void ThreadSafeUpdate(const FSimpleMovement& World2D, const FSimpleMovement& World, const FQuat& WorldQuat, bool bOnWall = false);
+	void ThreadSafeUpdate(const FSimpleMovement& World2D, const FSimpleMovement& World, const FRotator& WorldRotation, bool bOnWall = false)
+	{
+		ThreadSafeUpdate(World2D, World, WorldRotation.Quaternion(), bOnWall);
+	}
 
 	static float CalculateDirection(const FVector& Velocity, const FRotator& BaseRotation);
 	static float CalculateDirectionWall(const FVector& Velocity, const FRotator& BaseRotation);
 
-	void UpdateCardinals(const TMap<FGameplayTag, FSimpleCardinal>& NewCardinals);
+	/** Same as above but from a basis that has already been derived, avoids building a rotation matrix */
+	static float CalculateDirection(const FVector& Velocity, const FVector& ForwardVector, const FVector& RightVector);
+	static float CalculateDirectionWall(const FVector& Velocity, const FVector& UpVector, const FVector& RightVector);
+
+	void UpdateCardinals(const TMap<FGameplayTag, FSimpleCardinal>& NewCardinals) { Cardinals = NewCardinals; }
 	const TMap<FGameplayTag, FSimpleCardinal>& GetDefaultCardinals() const { return Cardinals; }
-	
-	void CacheCardinals();
 
-	const TMap<FGameplayTag, FSimpleCardinal>& GetCardinals(ESimpleCardinalCache Mode = ESimpleCardinalCache::CachedEnabledOnly) const;
-	TMap<FGameplayTag, FSimpleCardinal>& GetCardinals(ESimpleCardinalCache Mode = ESimpleCardinalCache::CachedEnabledOnly);
+	/** Frees the configuration once the shared configuration is in use, it is only needed to build the shared configuration */
+	void ReleaseDefaultCardinals() { Cardinals.Empty(); }
+
+	/** Use the shared configuration, results are reset to match its modes */
+	void SetConfig(const TSharedPtr<const FSimpleCardinalConfig>& InConfig);
+	const TSharedPtr<const FSimpleCardinalConfig>& GetConfig() const { return Config; }
+
+	/** Results for each enabled mode, at the same indices as FSimpleCardinalConfig::Modes */
+	TConstArrayView<FSimpleCardinal> GetResults() const { return Results; }
+
+	UE_DEPRECATED(1.2, "Results are no longer cached in a map, use GetCurrentResult() or GetResults() with GetConfig()")
+	TMap<FGameplayTag, FSimpleCardinal> GetCardinals(ESimpleCardinalCache Mode = ESimpleCardinalCache::CachedEnabledOnly) const;
+
+	UE_DEPRECATED(1.2, "Results are no longer cached in a map, the shared configuration is built by USimpleAnimInstance")
+	void CacheCardinals() {}
+
+	/** Called for each enabled mode every update, bound in USimpleAnimInstance::NativeInitializeAnimation */
+	FSimpleCardinalUpdate UpdateDelegate;
 	
 protected:
-	UPROPERTY(BlueprintReadOnly, Category=Properties)
-	bool bHasCachedCardinals;
-
+	/**
+	 * Configuration of each cardinal mode, only kept by the class defaults once the shared configuration is built
+	 * Instances read their results with GetSimpleCardinalResult() instead
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Properties, meta=(GameplayTagFilter="Simple.Mode"))
 	TMap<FGameplayTag, FSimpleCardinal> Cardinals;
 
-	/** Cache only the cardinals that are enabled */
-	UPROPERTY(BlueprintReadOnly, Category=Properties, meta=(GameplayTagFilter="Simple.Mode"))
-	TMap<FGameplayTag, FSimpleCardinal> CachedCardinals;
+	TSharedPtr<const FSimpleCardinalConfig> Config;
+	TArray<FSimpleCardinal> Results;
+
+	void ThreadSafeUpdate_Internal(const FSimpleMovement& World2D, const FSimpleMovement& World, const FQuat& WorldQuat, bool bOnWall = false);
 
-	void ThreadSafeUpdate_Internal(const FSimpleMovement& World2D, const FSimpleMovement& World, const FRotator& WorldRotation, bool bOnWall = false);
+	/** Result for the Simple.Mode, nullptr if it hasn't updated or the mode is not enabled */
+	const FSimpleCardinal* FindResult(const FGameplayTag& CardinalModeTag, const ANSICHAR* Context) const;
 };
 
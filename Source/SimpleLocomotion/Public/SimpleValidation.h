@@ -0,0 +1,74 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "SimpleTypes.h"
+
+#ifndef WITH_SIMPLE_VALIDATION
+#define WITH_SIMPLE_VALIDATION !UE_BUILD_SHIPPING
+#endif
+
+#if WITH_SIMPLE_VALIDATION
+
+/** Inputs for NativeThreadSafeUpdateGaitMode() */
+struct FSimpleGaitInput
+{
+	const FSimpleGaitSpeed* MaxGaitSpeeds = nullptr;
+	float Speed = 0.f;
+	bool bHasAcceleration = false;
+	bool bIsStrolling = false;
+	bool bIsWalking = false;
+	bool bIsSprinting = false;
+	bool bWantsStrolling = false;
+	bool bWantsWalking = false;
+	bool bWantsSprinting = false;
+	FGameplayTag PrevStopGait;
+};
+
+/** Outputs of NativeThreadSafeUpdateGaitMode() */
+struct FSimpleGaitResult
+{
+	FGameplayTag Gait;
+	FGameplayTag StartGait;
+	FGameplayTag GaitSpeed;
+	FGameplayTag StopGait;
+
+	bool operator==(const FSimpleGaitResult& Other) const
+	{
+		return Gait == Other.Gait && StartGait == Other.StartGait && GaitSpeed == Other.GaitSpeed && StopGait == Other.StopGait;
+	}
+};
+
+using FSimpleSelectCardinalFunc = TFunction<FGameplayTag(const FGameplayTag& CardinalMode, float Angle, float DeadZone,
+	const FGameplayTag& CurrentDirection, bool bWasMovingLastUpdate)>;
+using FSimpleSelectBasicCardinalFunc = TFunction<FGameplayTag(const FGameplayTag& CardinalMode, float Angle)>;
+using FSimpleCalculateDirectionFunc = TFunction<float(const FVector& Velocity, const FRotator& BaseRotation)>;
+using FSimpleGaitModeFunc = TFunction<FSimpleGaitResult(const FSimpleGaitInput& Input)>;
+
+/**
+ * Differential validation of cardinal and gait selection
+ * A frozen copy of the original implementation is the reference, every registered candidate is swept against it and
+ * mismatches and timings are reported side by side. The live implementations are always registered as "Live"
+ *
+ * Runs as the SimpleLocomotion.Validation.Reference automation test, or with a.SimpleAnim.Validate [AngleStep] [CandidateFilter]
+ */
+namespace FSimpleValidation
+{
+	SIMPLELOCOMOTION_API void RegisterSelectCardinal(FName Name, FSimpleSelectCardinalFunc Func);
+	SIMPLELOCOMOTION_API void RegisterSelectBasicCardinal(FName Name, FSimpleSelectBasicCardinalFunc Func);
+	SIMPLELOCOMOTION_API void RegisterCalculateDirection(FName Name, FSimpleCalculateDirectionFunc Func);
+	SIMPLELOCOMOTION_API void RegisterGaitMode(FName Name, FSimpleGaitModeFunc Func);
+	SIMPLELOCOMOTION_API void UnregisterCandidate(FName Name);
+
+	/**
+	 * Sweep every registered candidate against the reference
+	 * @param AngleStep - Resolution of the angle sweep in degrees, boundaries and their neighbouring floats are always included
+	 * @param Filter - Only candidates whose name contains this are validated, empty validates all
+	 * @return True if no candidate mismatched the reference
+	 */
+	SIMPLELOCOMOTION_API bool RunValidation(float AngleStep = 0.1f, const FString& Filter = {});
+}
+
+#endif
@@ -0,0 +1,150 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "SimpleCardinalModeCompilerExtension.h"
+
+#include "SimpleAnimInstance.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "KismetCompiler.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(SimpleCardinalModeCompilerExtension)
+
+#define LOCTEXT_NAMESPACE "SimpleCardinalModeCompilerExtension"
+
+void USimpleCardinalModeCompilerExtension::ProcessBlueprintCompiled(const FKismetCompilerContext& CompilationContext,
+	const FBlueprintCompiledData& Data)
+{
+	UClass* Class = CompilationContext.NewClass;
+	if (!Class || !Class->IsChildOf(USimpleAnimInstance::StaticClass()))
+	{
+		return;
+	}
+
+	USimpleAnimInstance* CDO = Cast<USimpleAnimInstance>(Class->GetDefaultObject(false));
+	if (!CDO)
+	{
+		return;
+	}
+
+	const FGameplayTag ModeRoot = FGameplayTag::RequestGameplayTag(TEXT("Simple.Mode"), false);
+	if (!ModeRoot.IsValid())
+	{
+		return;
+	}
+
+	FGameplayTagContainer Modes;
+
+	// Literal tags on graph pins, e.g. the CardinalMode of GetSimpleCardinalForTag
+	TArray<UBlueprint*> Blueprints;
+	UBlueprint::GetBlueprintHierarchyFromClass(Class, Blueprints);
+	for (const UBlueprint* Blueprint : Blueprints)
+	{
+		TArray<UEdGraph*> Graphs;
+		Blueprint->GetAllGraphs(Graphs);
+		for (const UEdGraph* Graph : Graphs)
+		{
+			for (const UEdGraphNode* Node : Graph->Nodes)
+			{
+				if (!Node)
+				{
+					continue;
+				}
+				
+				for (const UEdGraphPin* Pin : Node->Pins)
+				{
+					if (Pin && Pin->LinkedTo.Num() == 0 && Pin->PinType.PinSubCategoryObject == FGameplayTag::StaticStruct())
+					{
+						FGameplayTag Tag;
+						if (Tag.FromExportString(Pin->GetDefaultAsString()) && Tag.MatchesTag(ModeRoot))
+						{
+							Modes.AddTag(Tag);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Tags held by the class defaults, e.g. FSimpleStrafeLocoSet::Mode
+	for (TFieldIterator<FProperty> It(Class); It; ++It)
+	{
+		// Results of previous scans, not references
+		if (It->GetFName() == GET_MEMBER_NAME_CHECKED(USimpleAnimInstance, ReferencedCardinalModes) ||
+			It->GetFName() == GET_MEMBER_NAME_CHECKED(USimpleAnimInstance, CookStrippedCardinalModes))
+		{
+			continue;
+		}
+
+		for (int32 Index = 0; Index < It->ArrayDim; Index++)
+		{
+			GatherModesFromProperty(*It, It->ContainerPtrToValuePtr<void>(CDO, Index), ModeRoot, Modes);
+		}
+	}
+
+	for (const auto& CardinalItr : CDO->Cardinals.GetDefaultCardinals())
+	{
+		if (CardinalItr.Value.bEnabled && !Modes.HasTagExact(CardinalItr.Key))
+		{
+			CompilationContext.MessageLog.Warning(*FText::Format(
+				LOCTEXT("UnusedCardinalMode", "Cardinal mode {0} is enabled but never referenced, it is still computed every update. Disable it in Cardinals or enable bStripUnusedCardinalModesOnCook"),
+				FText::FromName(CardinalItr.Key.GetTagName())).ToString());
+		}
+	}
+
+	CDO->ReferencedCardinalModes = Modes;
+	CDO->bHasScannedCardinalModes = true;
+}
+
+void USimpleCardinalModeCompilerExtension::GatherModesFromProperty(const FProperty* Property, const void* ValuePtr,
+	const FGameplayTag& ModeRoot, FGameplayTagContainer& OutModes)
+{
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		if (StructProperty->Struct == FGameplayTag::StaticStruct())
+		{
+			const FGameplayTag& Tag = *static_cast<const FGameplayTag*>(ValuePtr);
+			if (Tag.MatchesTag(ModeRoot))
+			{
+				OutModes.AddTag(Tag);
+			}
+			return;
+		}
+
+		// These are the modes being checked, not references to them
+		if (StructProperty->Struct == FSimpleCardinals::StaticStruct())
+		{
+			return;
+		}
+
+		for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+		{
+			for (int32 Index = 0; Index < It->ArrayDim; Index++)
+			{
+				GatherModesFromProperty(*It, It->ContainerPtrToValuePtr<void>(ValuePtr, Index), ModeRoot, OutModes);
+			}
+		}
+	}
+	else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+		for (int32 Index = 0; Index < Helper.Num(); Index++)
+		{
+			GatherModesFromProperty(ArrayProperty->Inner, Helper.GetRawPtr(Index), ModeRoot, OutModes);
+		}
+	}
+	else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		FScriptMapHelper Helper(MapProperty, ValuePtr);
+		for (int32 Index = 0; Index < Helper.GetMaxIndex(); Index++)
+		{
+			if (Helper.IsValidIndex(Index))
+			{
+				GatherModesFromProperty(MapProperty->KeyProp, Helper.GetKeyPtr(Index), ModeRoot, OutModes);
+				GatherModesFromProperty(MapProperty->ValueProp, Helper.GetValuePtr(Index), ModeRoot, OutModes);
+			}
+		}
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,25 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintCompilerExtension.h"
+#include "GameplayTagContainer.h"
+#include "SimpleCardinalModeCompilerExtension.generated.h"
+
+/**
+ * Finds the Simple.Mode tags an Animation Blueprint deriving from USimpleAnimInstance references when it compiles
+ * Literal tags on graph pins and tags held by the class defaults (e.g. set Mode properties) are considered references
+ * Warns about enabled cardinal modes that aren't referenced and records the references for USimpleAnimInstance::PreSave()
+ */
+UCLASS()
+class USimpleCardinalModeCompilerExtension : public UBlueprintCompilerExtension
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void ProcessBlueprintCompiled(const FKismetCompilerContext& CompilationContext, const FBlueprintCompiledData& Data) override;
+
+	static void GatherModesFromProperty(const FProperty* Property, const void* ValuePtr, const FGameplayTag& ModeRoot,
+		FGameplayTagContainer& OutModes);
+};
@@ -0,0 +1,685 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "SimpleLocoSetAutoFill.h"
+
+#include "GameplayTagsManager.h"
+#include "IPropertyUtilities.h"
+#include "PropertyHandle.h"
+#include "ScopedTransaction.h"
+#include "SimpleSets.h"
+#include "SimpleTags.h"
+#include "Animation/AnimSequence.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Internationalization/Regex.h"
+#include "Logging/MessageLog.h"
+#include "Tasks/Task.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(SimpleLocoSetAutoFill)
+
+#define LOCTEXT_NAMESPACE "SimpleLocoSetAutoFill"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSimpleLocoSetAutoFill, Log, All);
+
+const FName FSimpleLocoSetAutoFill::MessageLogName = TEXT("SimpleLocomotion");
+int32 FSimpleLocoSetAutoFill::NumRunning = 0;
+
+USimpleLocoSetAutoFillSettings::USimpleLocoSetAutoFillSettings()
+{
+	NamePattern = TEXT("*_{Stance}_{Gait}_{Cardinal}");
+
+	Aliases.Add(FSimpleTags::Simple_Stance_Crouch, TEXT("Crouch|Crouched|Crch"));
+	Aliases.Add(FSimpleTags::Simple_Cardinal_Forward, TEXT("Fwd|Forward|F"));
+	Aliases.Add(FSimpleTags::Simple_Cardinal_Forward_Left, TEXT("Fwd_Left|Fwd_L|Forward_Left|FL"));
+	Aliases.Add(FSimpleTags::Simple_Cardinal_Forward_Right, TEXT("Fwd_Right|Fwd_R|Forward_Right|FR"));
+	Aliases.Add(FSimpleTags::Simple_Cardinal_Left, TEXT("Left|L"));
+	Aliases.Add(FSimpleTags::Simple_Cardinal_Right, TEXT("Right|R"));
+	Aliases.Add(FSimpleTags::Simple_Cardinal_Left_Away, TEXT("Left_Away|LeftAway|LA"));
+	Aliases.Add(FSimpleTags::Simple_Cardinal_Right_Away, TEXT("Right_Away|RightAway|RA"));
+	Aliases.Add(FSimpleTags::Simple_Cardinal_Backward, TEXT("Bwd|Backward|B"));
+	Aliases.Add(FSimpleTags::Simple_Cardinal_Backward_Left, TEXT("Bwd_Left|Bwd_L|Backward_Left|BL"));
+	Aliases.Add(FSimpleTags::Simple_Cardinal_Backward_Right, TEXT("Bwd_Right|Bwd_R|Backward_Right|BR"));
+}
+
+namespace SimpleAutoFill
+{
+	enum EToken : int32
+	{
+		Token_State,
+		Token_Stance,
+		Token_Gait,
+		Token_Cardinal,
+		Token_Num
+	};
+
+	static const TCHAR* TokenNames[Token_Num] = { TEXT("{State}"), TEXT("{Stance}"), TEXT("{Gait}"), TEXT("{Cardinal}") };
+
+	/** The name pattern converted to a regex, with the tag each alias resolves to */
+	struct FCompiledPattern
+	{
+		FString Regex;
+		int32 Groups[Token_Num] = { INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE };
+		TMap<FString, FGameplayTag> AliasToTag[Token_Num];
+	};
+
+	struct FMatch
+	{
+		FGameplayTag Tags[Token_Num];
+		FSoftObjectPath Path;
+		FString Name;
+	};
+
+	/** What is being filled, resolved on the game thread before matching starts */
+	struct FRequest
+	{
+		TSharedPtr<IPropertyHandle> PropertyHandle;
+		TWeakPtr<IPropertyUtilities> PropertyUtilities;
+		bool bStateSet = false;
+		bool bOverwriteExisting = false;
+
+		/** When filling a gait set nested in a stance or state map, only matches for that stance or state are used */
+		FGameplayTag FixedState;
+		FGameplayTag FixedStance;
+	};
+
+	static FString EscapeRegex(const FString& Literal)
+	{
+		static const FString Special = TEXT("\\^$.|?*+()[]{}");
+		FString Result;
+		Result.Reserve(Literal.Len() * 2);
+		for (const TCHAR Char : Literal)
+		{
+			int32 Index;
+			if (Special.FindChar(Char, Index))
+			{
+				Result.AppendChar(TEXT('\\'));
+			}
+			Result.AppendChar(Char);
+		}
+		return Result;
+	}
+
+	static FGameplayTag GetRootTag(EToken Token)
+	{
+		switch (Token)
+		{
+		case Token_State: return FSimpleTags::Simple_State;
+		case Token_Stance: return FGameplayTag::RequestGameplayTag(TEXT("Simple.Stance"), false);
+		case Token_Gait: return FGameplayTag::RequestGameplayTag(TEXT("Simple.Gait"), false);
+		case Token_Cardinal: return FGameplayTag::RequestGameplayTag(TEXT("Simple.Cardinal"), false);
+		default: return FGameplayTag::EmptyTag;
+		}
+	}
+
+	static TArray<FGameplayTag> GetTokenTags(EToken Token)
+	{
+		if (Token == Token_Cardinal)
+		{
+			// Only the cardinals a strafe set can hold
+			return {
+				FSimpleTags::Simple_Cardinal_Forward, FSimpleTags::Simple_Cardinal_Forward_Left, FSimpleTags::Simple_Cardinal_Forward_Right,
+				FSimpleTags::Simple_Cardinal_Left, FSimpleTags::Simple_Cardinal_Right, FSimpleTags::Simple_Cardinal_Left_Away,
+				FSimpleTags::Simple_Cardinal_Right_Away, FSimpleTags::Simple_Cardinal_Backward, FSimpleTags::Simple_Cardinal_Backward_Left,
+				FSimpleTags::Simple_Cardinal_Backward_Right
+			};
+		}
+
+		TArray<FGameplayTag> Tags;
+		const FGameplayTag Root = GetRootTag(Token);
+		if (Root.IsValid())
+		{
+			UGameplayTagsManager::Get().RequestGameplayTagChildren(Root).GetGameplayTagArray(Tags);
+		}
+		return Tags;
+	}
+
+	static FCompiledPattern Compile(const USimpleLocoSetAutoFillSettings* Settings)
+	{
+		FCompiledPattern Compiled;
+
+		// Resolve aliases for every token, longest first so Fwd_Left is preferred over Fwd
+		TArray<FString> Alternatives[Token_Num];
+		for (int32 Token = 0; Token < Token_Num; Token++)
+		{
+			for (const FGameplayTag& Tag : GetTokenTags(static_cast<EToken>(Token)))
+			{
+				FString AliasString;
+				if (const FString* Alias = Settings->Aliases.Find(Tag))
+				{
+					AliasString = *Alias;
+				}
+				else
+				{
+					const FString TagString = Tag.ToString();
+					int32 DotIndex;
+					AliasString = TagString.FindLastChar(TEXT('.'), DotIndex) ? TagString.RightChop(DotIndex + 1) : TagString;
+				}
+
+				TArray<FString> Parts;
+				AliasString.ParseIntoArray(Parts, TEXT("|"));
+				for (FString& Part : Parts)
+				{
+					Part.TrimStartAndEndInline();
+					Part.ToLowerInline();
+					if (!Part.IsEmpty() && !Compiled.AliasToTag[Token].Contains(Part))
+					{
+						Compiled.AliasToTag[Token].Add(Part, Tag);
+						Alternatives[Token].Add(EscapeRegex(Part));
+					}
+				}
+			}
+			Alternatives[Token].Sort([](const FString& A, const FString& B) { return A.Len() > B.Len(); });
+		}
+
+		// Convert the pattern, tokens become capture groups
+		const FString Pattern = Settings->NamePattern.ToLower();
+		int32 NumGroups = 0;
+		Compiled.Regex = TEXT("^");
+		for (int32 i = 0; i < Pattern.Len();)
+		{
+			bool bToken = false;
+			for (int32 Token = 0; Token < Token_Num; Token++)
+			{
+				const FString TokenName = FString(TokenNames[Token]).ToLower();
+				if (FCString::Strncmp(*Pattern + i, *TokenName, TokenName.Len()) == 0)
+				{
+					// Repeated tokens are matched but only the first is captured
+					const bool bCapture = Compiled.Groups[Token] == INDEX_NONE;
+					if (bCapture)
+					{
+						Compiled.Groups[Token] = ++NumGroups;
+					}
+					Compiled.Regex += bCapture ? TEXT("(") : TEXT("(?:");
+					Compiled.Regex += FString::Join(Alternatives[Token], TEXT("|"));
+					Compiled.Regex += TEXT(")");
+					i += TokenName.Len();
+					bToken = true;
+					break;
+				}
+			}
+
+			if (!bToken)
+			{
+				const TCHAR Char = Pattern[i++];
+				if (Char == TEXT('*'))
+				{
+					Compiled.Regex += TEXT(".*");
+				}
+				else if (Char == TEXT('?'))
+				{
+					Compiled.Regex += TEXT(".");
+				}
+				else
+				{
+					Compiled.Regex += EscapeRegex(FString(1, &Char));
+				}
+			}
+		}
+		Compiled.Regex += TEXT("$");
+
+		return Compiled;
+	}
+
+	/** Runs on a worker thread, nothing is loaded */
+	static TArray<FMatch> FindMatches(const FCompiledPattern& Compiled, const FARFilter& Filter, int32& OutNumAssets)
+	{
+		TArray<FAssetData> Assets;
+		IAssetRegistry::GetChecked().GetAssets(Filter, Assets);
+		OutNumAssets = Assets.Num();
+
+		const FRegexPattern Pattern(Compiled.Regex);
+
+		TArray<FMatch> Matches;
+		for (const FAssetData& Asset : Assets)
+		{
+			const FString Name = Asset.AssetName.ToString();
+			FRegexMatcher Matcher(Pattern, Name.ToLower());
+			if (!Matcher.FindNext())
+			{
+				continue;
+			}
+
+			FMatch Match;
+			Match.Path = Asset.GetSoftObjectPath();
+			Match.Name = Name;
+
+			bool bValid = true;
+			for (int32 Token = 0; Token < Token_Num; Token++)
+			{
+				if (Compiled.Groups[Token] != INDEX_NONE)
+				{
+					const FGameplayTag* Tag = Compiled.AliasToTag[Token].Find(Matcher.GetCaptureGroup(Compiled.Groups[Token]));
+					bValid &= Tag != nullptr;
+					Match.Tags[Token] = Tag ? *Tag : FGameplayTag::EmptyTag;
+				}
+			}
+
+			if (bValid)
+			{
+				Matches.Add(MoveTemp(Match));
+			}
+		}
+		return Matches;
+	}
+
+	static TObjectPtr<UAnimSequence>* GetSlot(FSimpleStrafeLocoSet& Set, const FGameplayTag& Cardinal)
+	{
+		if (Cardinal == FSimpleTags::Simple_Cardinal_Forward) { return &Set.Forward; }
+		if (Cardinal == FSimpleTags::Simple_Cardinal_Forward_Left) { return &Set.ForwardLeft; }
+		if (Cardinal == FSimpleTags::Simple_Cardinal_Forward_Right) { return &Set.ForwardRight; }
+		if (Cardinal == FSimpleTags::Simple_Cardinal_Left) { return &Set.Left; }
+		if (Cardinal == FSimpleTags::Simple_Cardinal_Right) { return &Set.Right; }
+		if (Cardinal == FSimpleTags::Simple_Cardinal_Left_Away) { return &Set.LeftAway; }
+		if (Cardinal == FSimpleTags::Simple_Cardinal_Right_Away) { return &Set.RightAway; }
+		if (Cardinal == FSimpleTags::Simple_Cardinal_Backward) { return &Set.Backward; }
+		if (Cardinal == FSimpleTags::Simple_Cardinal_Backward_Left) { return &Set.BackwardLeft; }
+		if (Cardinal == FSimpleTags::Simple_Cardinal_Backward_Right) { return &Set.BackwardRight; }
+		return nullptr;
+	}
+
+	/** Cardinals the set's Mode will request */
+	static TArray<FGameplayTag> GetRequiredCardinals(const FSimpleStrafeLocoSet& Set)
+	{
+		using namespace FSimpleTags;
+
+		const bool bAway = !Set.bDisableAway;
+		if (Set.Mode == Simple_Mode_Strafe_1Way) { return { Simple_Cardinal_Forward }; }
+		if (Set.Mode == Simple_Mode_Strafe_2Way) { return { Simple_Cardinal_Left, Simple_Cardinal_Right }; }
+		if (Set.Mode == Simple_Mode_Strafe_4Way) { return { Simple_Cardinal_Forward, Simple_Cardinal_Left, Simple_Cardinal_Right, Simple_Cardinal_Backward }; }
+
+		TArray<FGameplayTag> Cardinals = { Simple_Cardinal_Forward, Simple_Cardinal_Left, Simple_Cardinal_Right, Simple_Cardinal_Backward };
+		if (Set.Mode == Simple_Mode_Strafe_8Way || Set.Mode == Simple_Mode_Strafe_10Way)
+		{
+			Cardinals.Append({ Simple_Cardinal_Forward_Left, Simple_Cardinal_Forward_Right, Simple_Cardinal_Backward_Left, Simple_Cardinal_Backward_Right });
+		}
+		if (bAway && (Set.Mode == Simple_Mode_Strafe_6Way || Set.Mode == Simple_Mode_Strafe_10Way))
+		{
+			Cardinals.Append({ Simple_Cardinal_Left_Away, Simple_Cardinal_Right_Away });
+		}
+		return Cardinals;
+	}
+
+	/** Smallest mode that uses every assigned cardinal, only applied to sets created by the auto fill */
+	static FGameplayTag GetModeForSet(const FSimpleStrafeLocoSet& Set)
+	{
+		const bool bDiagonal = Set.ForwardLeft || Set.ForwardRight || Set.BackwardLeft || Set.BackwardRight;
+		const bool bAway = Set.LeftAway || Set.RightAway;
+		if (bDiagonal)
+		{
+			return bAway ? FSimpleTags::Simple_Mode_Strafe_10Way : FSimpleTags::Simple_Mode_Strafe_8Way;
+		}
+		if (bAway)
+		{
+			return FSimpleTags::Simple_Mode_Strafe_6Way;
+		}
+		if (!Set.Forward && !Set.Backward && (Set.Left || Set.Right))
+		{
+			return FSimpleTags::Simple_Mode_Strafe_2Way;
+		}
+		if (Set.Forward && !Set.Backward && !Set.Left && !Set.Right)
+		{
+			return FSimpleTags::Simple_Mode_Strafe_1Way;
+		}
+		return FSimpleTags::Simple_Mode_Strafe_4Way;
+	}
+
+	/** Walk up the property chain to find the state and stance map keys a nested gait set lives under */
+	static void ResolveContext(const TSharedRef<IPropertyHandle>& PropertyHandle, FRequest& Request)
+	{
+		const FGameplayTag StateRoot = GetRootTag(Token_State);
+		const FGameplayTag StanceRoot = GetRootTag(Token_Stance);
+
+		for (TSharedPtr<IPropertyHandle> Handle = PropertyHandle; Handle.IsValid(); Handle = Handle->GetParentHandle())
+		{
+			const TSharedPtr<IPropertyHandle> KeyHandle = Handle->GetKeyHandle();
+			if (!KeyHandle.IsValid())
+			{
+				continue;
+			}
+
+			void* KeyData = nullptr;
+			if (KeyHandle->GetValueData(KeyData) != FPropertyAccess::Success || !KeyData)
+			{
+				continue;
+			}
+
+			const FGameplayTag& Key = *static_cast<const FGameplayTag*>(KeyData);
+			if (!Request.FixedState.IsValid() && Key.MatchesTag(StateRoot))
+			{
+				Request.FixedState = Key;
+			}
+			else if (!Request.FixedStance.IsValid() && StanceRoot.IsValid() && Key.MatchesTag(StanceRoot))
+			{
+				Request.FixedStance = Key;
+			}
+		}
+	}
+
+	/** Lower is preferred when several assets map to the same slot */
+	static int32 GetPriority(const FMatch& Match, const FRequest& Request)
+	{
+		int32 Priority = 0;
+		if (!Request.bStateSet)
+		{
+			// Collapsed dimensions prefer the defaults
+			Priority += Match.Tags[Token_State].IsValid() && Match.Tags[Token_State] != FSimpleTags::Simple_State_Default ? 2 : 0;
+			Priority += Match.Tags[Token_Stance].IsValid() && Match.Tags[Token_Stance] != FSimpleTags::Simple_Stance_Stand ? 1 : 0;
+		}
+		return Priority;
+	}
+
+	struct FSlotKey
+	{
+		FGameplayTag State;
+		FGameplayTag Stance;
+		FGameplayTag Gait;
+		FGameplayTag Cardinal;
+
+		bool operator==(const FSlotKey& Other) const
+		{
+			return State == Other.State && Stance == Other.Stance && Gait == Other.Gait && Cardinal == Other.Cardinal;
+		}
+
+		friend uint32 GetTypeHash(const FSlotKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.State), GetTypeHash(Key.Stance)), HashCombine(GetTypeHash(Key.Gait), GetTypeHash(Key.Cardinal)));
+		}
+	};
+
+	/** Resolve each slot to a single match, returns the number of slots that had more than one candidate */
+	static int32 SelectMatches(const TArray<FMatch>& Matches, const FRequest& Request, TMap<FSlotKey, const FMatch*>& OutSlots)
+	{
+		int32 NumAmbiguous = 0;
+		TSet<FSlotKey> Ambiguous;
+		for (const FMatch& Match : Matches)
+		{
+			const FGameplayTag& State = Match.Tags[Token_State];
+			const FGameplayTag& Stance = Match.Tags[Token_Stance];
+			if ((Request.FixedState.IsValid() && State.IsValid() && State != Request.FixedState) ||
+				(Request.FixedStance.IsValid() && Stance.IsValid() && Stance != Request.FixedStance))
+			{
+				continue;
+			}
+
+			FSlotKey Key;
+			Key.Gait = Match.Tags[Token_Gait].IsValid() ? Match.Tags[Token_Gait] : FSimpleTags::Simple_Gait_Run.GetTag();
+			Key.Cardinal = Match.Tags[Token_Cardinal];
+			if (Request.bStateSet)
+			{
+				Key.State = State.IsValid() ? State : FSimpleTags::Simple_State_Default.GetTag();
+				Key.Stance = Stance.IsValid() ? Stance : FSimpleTags::Simple_Stance_Stand.GetTag();
+			}
+
+			const FMatch*& Existing = OutSlots.FindOrAdd(Key, nullptr);
+			if (!Existing)
+			{
+				Existing = &Match;
+				continue;
+			}
+
+			const int32 NewPriority = GetPriority(Match, Request);
+			const int32 ExistingPriority = GetPriority(*Existing, Request);
+			if (NewPriority == ExistingPriority)
+			{
+				bool bAlreadyInSet = false;
+				Ambiguous.Add(Key, &bAlreadyInSet);
+				NumAmbiguous += bAlreadyInSet ? 0 : 1;
+			}
+
+			// Deterministic: priority, then the shortest name, then alphabetical
+			if (NewPriority < ExistingPriority || (NewPriority == ExistingPriority &&
+				(Match.Name.Len() < Existing->Name.Len() || (Match.Name.Len() == Existing->Name.Len() && Match.Name < Existing->Name))))
+			{
+				Existing = &Match;
+			}
+		}
+		return NumAmbiguous;
+	}
+
+	struct FFillResult
+	{
+		int32 NumAssigned = 0;
+		int32 NumSkipped = 0;
+		TArray<FString> Gaps;
+	};
+
+	static void FillStrafeSet(FSimpleStrafeLocoSet& Set, bool bCreated, const TMap<FGameplayTag, UAnimSequence*>& Cardinals,
+		bool bOverwriteExisting, const FString& Context, FFillResult& Result)
+	{
+		for (const TPair<FGameplayTag, UAnimSequence*>& Cardinal : Cardinals)
+		{
+			if (TObjectPtr<UAnimSequence>* Slot = GetSlot(Set, Cardinal.Key))
+			{
+				if (*Slot && !bOverwriteExisting)
+				{
+					Result.NumSkipped++;
+					continue;
+				}
+				*Slot = Cardinal.Value;
+				Result.NumAssigned++;
+			}
+		}
+
+		if (bCreated)
+		{
+			Set.Mode = GetModeForSet(Set);
+		}
+
+		for (const FGameplayTag& Required : GetRequiredCardinals(Set))
+		{
+			const TObjectPtr<UAnimSequence>* Slot = GetSlot(Set, Required);
+			if (Slot && !*Slot)
+			{
+				Result.Gaps.Add(FString::Printf(TEXT("%s %s"), *Context, *Required.ToString()));
+			}
+		}
+	}
+
+	static void FillGaitSet(FSimpleStrafeGaitSet& GaitSet, const TMap<FGameplayTag, TMap<FGameplayTag, UAnimSequence*>>& Gaits,
+		bool bOverwriteExisting, const FString& Context, FFillResult& Result)
+	{
+		for (const TPair<FGameplayTag, TMap<FGameplayTag, UAnimSequence*>>& Gait : Gaits)
+		{
+			const bool bCreated = !GaitSet.GaitSets.Contains(Gait.Key);
+			FSimpleStrafeLocoSet& Set = GaitSet.GaitSets.FindOrAdd(Gait.Key);
+			FillStrafeSet(Set, bCreated, Gait.Value, bOverwriteExisting, Context + Gait.Key.ToString(), Result);
+		}
+	}
+
+	/** Game thread, all matched sequences are loaded */
+	static void Apply(const FRequest& Request, const TMap<FSlotKey, const FMatch*>& Slots, int32 NumAmbiguous)
+	{
+		FMessageLog MessageLog(FSimpleLocoSetAutoFill::MessageLogName);
+
+		if (!Request.PropertyHandle.IsValid() || !Request.PropertyHandle->IsValidHandle())
+		{
+			MessageLog.Warning(LOCTEXT("HandleInvalid", "Auto Fill: the set was closed before matching finished, nothing was changed"));
+			MessageLog.Notify();
+			return;
+		}
+
+		// State -> Stance -> Gait -> Cardinal
+		TMap<FGameplayTag, TMap<FGameplayTag, TMap<FGameplayTag, TMap<FGameplayTag, UAnimSequence*>>>> Hierarchy;
+		for (const TPair<FSlotKey, const FMatch*>& Slot : Slots)
+		{
+			if (UAnimSequence* Anim = Cast<UAnimSequence>(Slot.Value->Path.ResolveObject()))
+			{
+				Hierarchy.FindOrAdd(Slot.Key.State).FindOrAdd(Slot.Key.Stance).FindOrAdd(Slot.Key.Gait).Add(Slot.Key.Cardinal, Anim);
+			}
+		}
+
+		const FScopedTransaction Transaction(LOCTEXT("AutoFillTransaction", "Auto Fill Strafe Gait Set"));
+
+		TArray<UObject*> Outers;
+		Request.PropertyHandle->GetOuterObjects(Outers);
+		for (UObject* Outer : Outers)
+		{
+			Outer->Modify();
+		}
+
+		Request.PropertyHandle->NotifyPreChange();
+
+		TArray<void*> RawData;
+		Request.PropertyHandle->AccessRawData(RawData);
+
+		FFillResult Result;
+		for (void* Data : RawData)
+		{
+			if (!Data)
+			{
+				continue;
+			}
+
+			if (Request.bStateSet)
+			{
+				FSimpleStateToStanceToStrafeGaitSet& StateSet = *static_cast<FSimpleStateToStanceToStrafeGaitSet*>(Data);
+				for (const auto& State : Hierarchy)
+				{
+					FSimpleStanceToStrafeGaitSet& StanceSet = StateSet.StateSets.FindOrAdd(State.Key);
+					for (const auto& Stance : State.Value)
+					{
+						FSimpleStrafeGaitSet& GaitSet = StanceSet.StanceSets.FindOrAdd(Stance.Key);
+						const FString Context = FString::Printf(TEXT("%s %s "), *State.Key.ToString(), *Stance.Key.ToString());
+						FillGaitSet(GaitSet, Stance.Value, Request.bOverwriteExisting, Context, Result);
+					}
+				}
+			}
+			else if (const auto* State = Hierarchy.Find(FGameplayTag::EmptyTag))
+			{
+				if (const auto* Stance = State->Find(FGameplayTag::EmptyTag))
+				{
+					FillGaitSet(*static_cast<FSimpleStrafeGaitSet*>(Data), *Stance, Request.bOverwriteExisting, FString(), Result);
+				}
+			}
+		}
+
+		Request.PropertyHandle->NotifyPostChange(EPropertyChangeType::ValueSet);
+		Request.PropertyHandle->NotifyFinishedChangingProperties();
+
+		// Map entries may have been added, rebuild once now that everything is applied
+		if (const TSharedPtr<IPropertyUtilities> PropertyUtilities = Request.PropertyUtilities.Pin())
+		{
+			PropertyUtilities->RequestRefresh();
+		}
+
+		MessageLog.Info(FText::Format(LOCTEXT("AutoFillResult", "Auto Fill: assigned {0} animations, kept {1} existing, {2} slots had more than one match"),
+			FText::AsNumber(Result.NumAssigned), FText::AsNumber(Result.NumSkipped), FText::AsNumber(NumAmbiguous)));
+
+		for (const FString& Gap : Result.Gaps)
+		{
+			MessageLog.Warning(FText::Format(LOCTEXT("AutoFillGap", "Auto Fill: no animation found for {0}"), FText::FromString(Gap)));
+		}
+
+		if (Result.Gaps.Num() > 0 || NumAmbiguous > 0)
+		{
+			MessageLog.Notify(LOCTEXT("AutoFillNotify", "Auto Fill finished with gaps"), EMessageSeverity::Warning);
+		}
+	}
+}
+
+void FSimpleLocoSetAutoFill::Run(const TSharedRef<IPropertyHandle>& PropertyHandle, const TSharedPtr<IPropertyUtilities>& PropertyUtilities)
+{
+	using namespace SimpleAutoFill;
+
+	const FStructProperty* StructProperty = CastField<FStructProperty>(PropertyHandle->GetProperty());
+	if (!StructProperty)
+	{
+		return;
+	}
+
+	FRequest Request;
+	Request.PropertyHandle = PropertyHandle;
+	Request.PropertyUtilities = PropertyUtilities;
+	Request.bStateSet = StructProperty->Struct == FSimpleStateToStanceToStrafeGaitSet::StaticStruct();
+	if (!Request.bStateSet && StructProperty->Struct != FSimpleStrafeGaitSet::StaticStruct())
+	{
+		return;
+	}
+
+	const USimpleLocoSetAutoFillSettings* Settings = GetDefault<USimpleLocoSetAutoFillSettings>();
+	Request.bOverwriteExisting = Settings->bOverwriteExisting;
+	if (!Request.bStateSet)
+	{
+		ResolveContext(PropertyHandle, Request);
+	}
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UAnimSequence::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	Filter.bIncludeOnlyOnDiskAssets = true;  // In-memory assets can only be gathered on the game thread
+	for (const FDirectoryPath& SearchPath : Settings->SearchPaths)
+	{
+		if (!SearchPath.Path.IsEmpty())
+		{
+			Filter.PackagePaths.Add(*SearchPath.Path);
+		}
+	}
+
+	FCompiledPattern Compiled = Compile(Settings);
+
+	NumRunning++;
+
+	// The registry may still be discovering assets, start once it has finished so the results are complete
+	auto Start = [Request = MoveTemp(Request), Compiled = MoveTemp(Compiled), Filter = MoveTemp(Filter)]() mutable
+	{
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [Request = MoveTemp(Request), Compiled = MoveTemp(Compiled), Filter = MoveTemp(Filter)]() mutable
+		{
+			int32 NumAssets = 0;
+			TArray<FMatch> Matches = FindMatches(Compiled, Filter, NumAssets);
+
+			AsyncTask(ENamedThreads::GameThread, [Request = MoveTemp(Request), Matches = MoveTemp(Matches), NumAssets]() mutable
+			{
+				TSharedRef<TMap<FSlotKey, const FMatch*>> Slots = MakeShared<TMap<FSlotKey, const FMatch*>>();
+				const int32 NumAmbiguous = SelectMatches(Matches, Request, *Slots);
+
+				UE_LOG(LogSimpleLocoSetAutoFill, Log, TEXT("Auto Fill: %d of %d animation sequences matched, %d slots"), Matches.Num(), NumAssets, Slots->Num());
+
+				TArray<FSoftObjectPath> Paths;
+				for (const TPair<FSlotKey, const FMatch*>& Slot : *Slots)
+				{
+					Paths.AddUnique(Slot.Value->Path);
+				}
+
+				if (Paths.Num() == 0)
+				{
+					FMessageLog MessageLog(FSimpleLocoSetAutoFill::MessageLogName);
+					MessageLog.Warning(FText::Format(LOCTEXT("NoMatches", "Auto Fill: none of the {0} animation sequences matched the pattern"), FText::AsNumber(NumAssets)));
+					MessageLog.Notify();
+					NumRunning--;
+					return;
+				}
+
+				// Matches owns the data Slots points to, keep them alive until the load completes
+				TSharedRef<TArray<FMatch>> OwnedMatches = MakeShared<TArray<FMatch>>(MoveTemp(Matches));
+				UAssetManager::GetStreamableManager().RequestAsyncLoad(Paths, FStreamableDelegate::CreateLambda(
+					[Request = MoveTemp(Request), Slots, OwnedMatches, NumAmbiguous]()
+				{
+					Apply(Request, *Slots, NumAmbiguous);
+					NumRunning--;
+				}));
+			});
+		});
+	};
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		FMessageLog(MessageLogName).Info(LOCTEXT("WaitingForRegistry", "Auto Fill: waiting for the asset registry to finish discovering assets"));
+		TSharedRef<FDelegateHandle> Handle = MakeShared<FDelegateHandle>();
+		*Handle = AssetRegistry.OnFilesLoaded().AddLambda([Start = MoveTemp(Start), Handle]() mutable
+		{
+			Start();
+			IAssetRegistry::GetChecked().OnFilesLoaded().Remove(*Handle);
+		});
+	}
+	else
+	{
+		Start();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
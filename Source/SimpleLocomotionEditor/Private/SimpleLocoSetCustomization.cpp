@@ -0,0 +1,84 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "SimpleLocoSetCustomization.h"
+
+#include "DetailWidgetRow.h"
+#include "IDetailChildrenBuilder.h"
+
+void FSimpleLocoSetCustomization::CustomizeHeader(TSharedRef<IPropertyHandle> PropertyHandle, FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& CustomizationUtils)
+{
+	HeaderRow.NameContent()
+	[
+		PropertyHandle->CreatePropertyNameWidget()
+	];
+}
+
+void FSimpleLocoSetCustomization::AddModeProperty(IDetailChildrenBuilder& ChildBuilder, const TSharedPtr<IPropertyHandle>& InModeProperty)
+{
+	ModeProperty = InModeProperty;
+	ChildBuilder.AddProperty(ModeProperty.ToSharedRef());
+	CacheMode();
+
+	// Update the cache only, visibility picks it up on the next paint
+	const FSimpleDelegate OnModeChanged = FSimpleDelegate::CreateRaw(this, &FSimpleLocoSetCustomization::CacheMode);
+	ModeProperty->SetOnPropertyValueChanged(OnModeChanged);
+	ModeProperty->SetOnChildPropertyValueChanged(OnModeChanged);
+}
+
+void FSimpleLocoSetCustomization::CacheMode()
+{
+	CachedMode = FGameplayTag::EmptyTag;
+	if (!ModeProperty.IsValid() || !ModeProperty->IsValidHandle())
+	{
+		return;
+	}
+
+	TArray<void*> RawData;
+	ModeProperty->AccessRawData(RawData);
+
+	bool bFirst = true;
+	for (const void* Data : RawData)
+	{
+		if (const FGameplayTag* Tag = static_cast<const FGameplayTag*>(Data))
+		{
+			if (bFirst)
+			{
+				CachedMode = *Tag;
+				bFirst = false;
+			}
+			else if (*Tag != CachedMode)
+			{
+				CachedMode = FGameplayTag::EmptyTag;
+				return;
+			}
+		}
+	}
+}
+
+bool FSimpleLocoSetCustomization::GetBoolValue(const TSharedPtr<IPropertyHandle>& PropertyHandle)
+{
+	if (!PropertyHandle.IsValid() || !PropertyHandle->IsValidHandle())
+	{
+		return false;
+	}
+
+	TArray<void*> RawData;
+	PropertyHandle->AccessRawData(RawData);
+
+	bool bValue = RawData.Num() > 0;
+	for (const void* Data : RawData)
+	{
+		bValue &= Data && *static_cast<const bool*>(Data);
+	}
+	return bValue;
+}
+
+void FSimpleLocoSetCustomization::AddPropertyWithVisibility(IDetailChildrenBuilder& ChildBuilder, const TSharedPtr<IPropertyHandle>& PropertyHandle, TFunction<bool()> IsVisible)
+{
+	IDetailPropertyRow& PropertyRow = ChildBuilder.AddProperty(PropertyHandle.ToSharedRef());
+	PropertyRow.Visibility(TAttribute<EVisibility>::Create(TAttribute<EVisibility>::FGetter::CreateLambda([IsVisible = MoveTemp(IsVisible)]()
+	{
+		return IsVisible() ? EVisibility::Visible : EVisibility::Collapsed;
+	})));
+}
\ No newline at end of file
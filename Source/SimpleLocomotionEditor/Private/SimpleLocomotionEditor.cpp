@@ -4,10 +4,16 @@
 #include "SimpleAnimComponentCustomization.h"
 #include "SimpleAnimInstanceBase.h"
 #include "SimpleAnimInstanceCustomization.h"
+#include "SimpleCardinalModeCompilerExtension.h"
+#include "SimpleLocoSetAutoFill.h"
 #include "SimpleStartLocoSetCustomization.h"
+#include "SimpleStrafeGaitSetCustomization.h"
 #include "SimpleStrafeLocoSetCustomization.h"
 #include "SimpleStrafeMontageSetCustomization.h"
 #include "SimpleTurnLocoSetCustomization.h"
+#include "BlueprintCompilationManager.h"
+#include "MessageLogModule.h"
+#include "Animation/AnimBlueprint.h"
 
 #define LOCTEXT_NAMESPACE "FSimpleLocomotionEditorModule"
 
@@ -42,6 +48,22 @@ void FSimpleLocomotionEditorModule::StartupModule()
 	// FSimpleStrafeMontageSet (SimpleLocomotionTypes)
 	PropertyModule.RegisterCustomPropertyTypeLayout(TEXT("SimpleStrafeMontageSet"),
 		FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FSimpleStrafeMontageSetCustomization::MakeInstance));
+
+	// FSimpleStrafeGaitSet (SimpleLocomotionTypes)
+	PropertyModule.RegisterCustomPropertyTypeLayout(TEXT("SimpleStrafeGaitSet"),
+		FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FSimpleStrafeGaitSetCustomization::MakeInstance));
+
+	// FSimpleStateToStanceToStrafeGaitSet (SimpleLocomotionTypes)
+	PropertyModule.RegisterCustomPropertyTypeLayout(TEXT("SimpleStateToStanceToStrafeGaitSet"),
+		FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FSimpleStrafeGaitSetCustomization::MakeInstance));
+
+	// Auto Fill results
+	FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
+	MessageLogModule.RegisterLogListing(FSimpleLocoSetAutoFill::MessageLogName, LOCTEXT("SimpleLocomotionLog", "Simple Locomotion"));
+
+	// Cardinal mode references, the compilation manager holds the extension for the lifetime of the editor
+	FBlueprintCompilationManager::RegisterCompilerExtension(UAnimBlueprint::StaticClass(),
+		NewObject<USimpleCardinalModeCompilerExtension>(GetTransientPackage()));
 }
 
 void FSimpleLocomotionEditorModule::ShutdownModule()
@@ -56,6 +78,13 @@ void FSimpleLocomotionEditorModule::ShutdownModule()
 		PropertyModule->UnregisterCustomPropertyTypeLayout("SimpleStartLocoSet");
 		PropertyModule->UnregisterCustomPropertyTypeLayout("SimpleTurnLocoSet");
 		PropertyModule->UnregisterCustomPropertyTypeLayout("SimpleStrafeMontageSet");
+		PropertyModule->UnregisterCustomPropertyTypeLayout("SimpleStrafeGaitSet");
+		PropertyModule->UnregisterCustomPropertyTypeLayout("SimpleStateToStanceToStrafeGaitSet");
+	}
+
+	if (FMessageLogModule* MessageLogModule = FModuleManager::GetModulePtr<FMessageLogModule>("MessageLog"))
+	{
+		MessageLogModule->UnregisterLogListing(FSimpleLocoSetAutoFill::MessageLogName);
 	}
 }
 
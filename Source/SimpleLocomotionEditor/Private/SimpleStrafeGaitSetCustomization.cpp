@@ -0,0 +1,55 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "SimpleStrafeGaitSetCustomization.h"
+
+#include "DetailWidgetRow.h"
+#include "IDetailChildrenBuilder.h"
+#include "IPropertyUtilities.h"
+#include "SimpleLocoSetAutoFill.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "SimpleStrafeGaitSetCustomization"
+
+TSharedRef<IPropertyTypeCustomization> FSimpleStrafeGaitSetCustomization::MakeInstance()
+{
+	return MakeShared<FSimpleStrafeGaitSetCustomization>();
+}
+
+void FSimpleStrafeGaitSetCustomization::CustomizeHeader(TSharedRef<IPropertyHandle> PropertyHandle, FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& CustomizationUtils)
+{
+	const TSharedPtr<IPropertyUtilities> PropertyUtilities = CustomizationUtils.GetPropertyUtilities();
+
+	HeaderRow.NameContent()
+	[
+		PropertyHandle->CreatePropertyNameWidget()
+	]
+	.ValueContent()
+	[
+		SNew(SButton)
+		.Text(LOCTEXT("AutoFill", "Auto Fill"))
+		.ToolTipText(LOCTEXT("AutoFillTooltip", "Fill this set from animation names matching the pattern in Project Settings > Plugins > Simple Locomotion Auto Fill"))
+		.IsEnabled_Lambda([PropertyHandle]()
+		{
+			return PropertyHandle->IsEditable() && !FSimpleLocoSetAutoFill::IsRunning();
+		})
+		.OnClicked_Lambda([PropertyHandle, PropertyUtilities]()
+		{
+			FSimpleLocoSetAutoFill::Run(PropertyHandle, PropertyUtilities);
+			return FReply::Handled();
+		})
+	];
+}
+
+void FSimpleStrafeGaitSetCustomization::CustomizeChildren(TSharedRef<IPropertyHandle> PropertyHandle, IDetailChildrenBuilder& ChildBuilder, IPropertyTypeCustomizationUtils& CustomizationUtils)
+{
+	uint32 NumChildren = 0;
+	PropertyHandle->GetNumChildren(NumChildren);
+	for (uint32 i = 0; i < NumChildren; i++)
+	{
+		ChildBuilder.AddProperty(PropertyHandle->GetChildHandle(i).ToSharedRef());
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -3,110 +3,43 @@
 
 #include "SimpleStrafeLocoSetCustomization.h"
 
-#include "DetailWidgetRow.h"
 #include "IDetailChildrenBuilder.h"
-#include "IPropertyUtilities.h"
 #include "SimpleTags.h"
 #include "SimpleSets.h"
-#include "System/SimpleLocomotionVersioning.h"
 
 TSharedRef<IPropertyTypeCustomization> FSimpleStrafeLocoSetCustomization::MakeInstance()
 {
 	return MakeShared<FSimpleStrafeLocoSetCustomization>();
 }
 
-void FSimpleStrafeLocoSetCustomization::CustomizeHeader(TSharedRef<IPropertyHandle> PropertyHandle, FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& CustomizationUtils)
-{
-	HeaderRow.NameContent()
-	[
-		PropertyHandle->CreatePropertyNameWidget()
-	];
-}
-
 void FSimpleStrafeLocoSetCustomization::CustomizeChildren(TSharedRef<IPropertyHandle> PropertyHandle, IDetailChildrenBuilder& ChildBuilder, IPropertyTypeCustomizationUtils& CustomizationUtils)
 {
-	// Add Mode property
-	const TSharedPtr<IPropertyHandle> ModeProperty = PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, Mode));
-	ChildBuilder.AddProperty(ModeProperty.ToSharedRef());
-
-	// Force a refresh on the details panel when Mode property changes
-	ModeProperty->SetOnPropertyValueChanged(FSimpleDelegate::CreateLambda([this, &CustomizationUtils]()
-	{
-#if UE_5_04_OR_LATER
-		CustomizationUtils.GetPropertyUtilities().Get()->RequestForceRefresh();
-#else
-		CustomizationUtils.GetPropertyUtilities().Get()->ForceRefresh();
-#endif
-	}));
+	// Add Mode property, visibility below updates from the cached mode when it changes
+	AddModeProperty(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, Mode)));
 
-	// Check if we disabled inertial blending via FSimpleStrafeLocoSet::bDisableInertialBlending
-	const TSharedPtr<IPropertyHandle> DisableInertialBlendingProperty = PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, bDisableInertialBlending));
-	bool bDisableInertialBlending = false;
-	if (DisableInertialBlendingProperty.IsValid())
-	{
-		DisableInertialBlendingProperty->GetValue(bDisableInertialBlending);
-	}
-	
-	// Check if we disabled cardinal type via FSimpleStrafeLocoSet::bDisableCardinalType
-	const TSharedPtr<IPropertyHandle> DisableCardinalTypeProperty = PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, bDisableCardinalType));
-	bool bDisableCardinalType = false;
-	if (DisableCardinalTypeProperty.IsValid())
-	{
-		DisableCardinalTypeProperty->GetValue(bDisableCardinalType);
-	}
-	
-	// Check if we disabled away strafes via FSimpleStrafeLocoSet::bDisableAway
-	const TSharedPtr<IPropertyHandle> DisableAwayProperty = PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, bDisableAway));
-	bool bDisableAway = false;
-	if (DisableAwayProperty.IsValid())
-	{
-		DisableAwayProperty->GetValue(bDisableAway);
-	}
-	
-	// Determine the mode tag
-	FString ModeTagName;
-	FGameplayTag ModeTag;
-	if (ModeProperty->GetValueAsFormattedString(ModeTagName) == FPropertyAccess::Success)
-	{
-		// Remove the prefix and suffix to get the actual tag
-		ModeTagName.RemoveFromStart(TEXT("(TagName=\""));
-		ModeTagName.RemoveFromEnd(TEXT("\")"));
+	// These are set by the owning set and can't be edited, so they only need to be read once
+	const bool bDisableInertialBlending = GetBoolValue(PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, bDisableInertialBlending)));
+	const bool bDisableCardinalType = GetBoolValue(PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, bDisableCardinalType)));
+	const bool bDisableAway = GetBoolValue(PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, bDisableAway)));
 
-		ModeTag = FGameplayTag::RequestGameplayTag(FName(*ModeTagName));
-	}
-	
-	// Form booleans to conditionally toggle visibility
-	const bool b2Way = ModeTag == FSimpleTags::Simple_Mode_Strafe_2Way;
-	const bool b4Way = ModeTag == FSimpleTags::Simple_Mode_Strafe_4Way;
-	const bool b6Way = ModeTag == FSimpleTags::Simple_Mode_Strafe_6Way;
-	const bool b8Way = ModeTag == FSimpleTags::Simple_Mode_Strafe_8Way;
-	const bool b10Way = ModeTag == FSimpleTags::Simple_Mode_Strafe_10Way;
-
-	const bool bStrafe = b4Way || b6Way || b8Way || b10Way;
-	const bool bLateral = bStrafe || b2Way;
-	const bool bDiagonal = b8Way || b10Way;
-	const bool bAway = (b6Way || b10Way) && !bDisableAway;
+	// Form predicates to conditionally toggle visibility
+	auto Is2Way = [this] { return IsMode(FSimpleTags::Simple_Mode_Strafe_2Way); };
+	auto IsStrafe = [this] { return IsMode(FSimpleTags::Simple_Mode_Strafe_4Way) || IsMode(FSimpleTags::Simple_Mode_Strafe_6Way) || IsMode(FSimpleTags::Simple_Mode_Strafe_8Way) || IsMode(FSimpleTags::Simple_Mode_Strafe_10Way); };
+	auto IsLateral = [=] { return IsStrafe() || Is2Way(); };
+	auto IsDiagonal = [this] { return IsMode(FSimpleTags::Simple_Mode_Strafe_8Way) || IsMode(FSimpleTags::Simple_Mode_Strafe_10Way); };
+	auto IsAway = [this, bDisableAway] { return (IsMode(FSimpleTags::Simple_Mode_Strafe_6Way) || IsMode(FSimpleTags::Simple_Mode_Strafe_10Way)) && !bDisableAway; };
 
 	// Add with conditional visibility
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, InertialBlendTime)), !bDisableInertialBlending);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, Forward)), !b2Way);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, ForwardLeft)), bDiagonal);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, ForwardRight)), bDiagonal);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, Left)), bLateral);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, Right)), bLateral);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, LeftAway)), bAway);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, RightAway)), bAway);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, Backward)), bStrafe);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, BackwardLeft)), bDiagonal);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, BackwardRight)), bDiagonal);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, CardinalType)), !bDisableCardinalType);
-}
-
-void FSimpleStrafeLocoSetCustomization::AddPropertyWithVisibility(IDetailChildrenBuilder& ChildBuilder, const TSharedPtr<IPropertyHandle>& PropertyHandle, bool bVisible)
-{
-	IDetailPropertyRow& PropertyRow = ChildBuilder.AddProperty(PropertyHandle.ToSharedRef());
-	PropertyRow.Visibility(TAttribute<EVisibility>::Create(TAttribute<EVisibility>::FGetter::CreateLambda([=]()
-	{
-		return bVisible ? EVisibility::Visible : EVisibility::Collapsed;
-	})));
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, InertialBlendTime)), [bDisableInertialBlending] { return !bDisableInertialBlending; });
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, Forward)), [=] { return !Is2Way(); });
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, ForwardLeft)), IsDiagonal);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, ForwardRight)), IsDiagonal);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, Left)), IsLateral);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, Right)), IsLateral);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, LeftAway)), IsAway);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, RightAway)), IsAway);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, Backward)), IsStrafe);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, BackwardLeft)), IsDiagonal);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, BackwardRight)), IsDiagonal);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, CardinalType)), [bDisableCardinalType] { return !bDisableCardinalType; });
 }
\ No newline at end of file
@@ -3,85 +3,36 @@
 
 #include "SimpleTurnLocoSetCustomization.h"
 
-#include "DetailWidgetRow.h"
 #include "IDetailChildrenBuilder.h"
-#include "IPropertyUtilities.h"
 #include "SimpleTags.h"
 #include "SimpleSets.h"
-#include "System/SimpleLocomotionVersioning.h"
 
 TSharedRef<IPropertyTypeCustomization> FSimpleTurnLocoSetCustomization::MakeInstance()
 {
 	return MakeShared<FSimpleTurnLocoSetCustomization>();
 }
 
-void FSimpleTurnLocoSetCustomization::CustomizeHeader(TSharedRef<IPropertyHandle> PropertyHandle, FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& CustomizationUtils)
-{
-	HeaderRow.NameContent()
-	[
-		PropertyHandle->CreatePropertyNameWidget()
-	];
-}
-
 void FSimpleTurnLocoSetCustomization::CustomizeChildren(TSharedRef<IPropertyHandle> PropertyHandle, IDetailChildrenBuilder& ChildBuilder, IPropertyTypeCustomizationUtils& CustomizationUtils)
 {
-	// Add Mode property
-	const TSharedPtr<IPropertyHandle> ModeProperty = PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, Mode));
-	const TSharedPtr<IPropertyHandle> AngleProperty = PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, AngleTolerance));
-	ChildBuilder.AddProperty(ModeProperty.ToSharedRef());
-	ChildBuilder.AddProperty(AngleProperty.ToSharedRef());
+	// Add Mode property, visibility below updates from the cached mode when it changes
+	AddModeProperty(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, Mode)));
+	ChildBuilder.AddProperty(PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, AngleTolerance)).ToSharedRef());
 
-	// Force a refresh on the details panel when Mode property changes
-	ModeProperty->SetOnPropertyValueChanged(FSimpleDelegate::CreateLambda([this, &CustomizationUtils]()
-	{
-#if UE_5_04_OR_LATER
-		CustomizationUtils.GetPropertyUtilities().Get()->RequestForceRefresh();
-#else
-		CustomizationUtils.GetPropertyUtilities().Get()->ForceRefresh();
-#endif
-	}));
-	
-	// Check if we disabled cardinal type via FSimpleStrafeLocoSet::bDisableCardinalType
-	const TSharedPtr<IPropertyHandle> DisableCardinalTypeProperty = PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleStrafeLocoSet, bDisableCardinalType));
-	bool bDisableCardinalType = false;
-	if (DisableCardinalTypeProperty.IsValid())
-	{
-		DisableCardinalTypeProperty->GetValue(bDisableCardinalType);
-	}
-	
-	// Determine the mode tag
-	FString ModeTagName;
-	FGameplayTag ModeTag;
-	if (ModeProperty->GetValueAsFormattedString(ModeTagName) == FPropertyAccess::Success)
-	{
-		// Remove the prefix and suffix to get the actual tag
-		ModeTagName.RemoveFromStart(TEXT("(TagName=\""));
-		ModeTagName.RemoveFromEnd(TEXT("\")"));
+	// Set by the owning set and can't be edited, so it only needs to be read once
+	const bool bDisableCardinalType = GetBoolValue(PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, bDisableCardinalType)));
 
-		ModeTag = FGameplayTag::RequestGameplayTag(FName(*ModeTagName));
-	}
-	
-	// Form booleans to conditionally toggle visibility
-	const bool b4Way = ModeTag == FSimpleTags::Simple_Mode_Turn_4Way;
-	const bool b8Way = ModeTag == FSimpleTags::Simple_Mode_Turn_8Way;
-	
-	// Add with conditional visibility
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, ForwardLeft)), b8Way);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, ForwardRight)), b8Way);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, Left)), b4Way || b8Way);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, Right)), b4Way || b8Way);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, BackwardTurnLeft)), true);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, BackwardTurnRight)), true);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, BackwardLeft)), b8Way);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, BackwardRight)), b8Way);
-	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, CardinalType)), !bDisableCardinalType);
-}
+	// Form predicates to conditionally toggle visibility
+	auto Is8Way = [this] { return IsMode(FSimpleTags::Simple_Mode_Turn_8Way); };
+	auto IsLateral = [this] { return IsMode(FSimpleTags::Simple_Mode_Turn_4Way) || IsMode(FSimpleTags::Simple_Mode_Turn_8Way); };
 
-void FSimpleTurnLocoSetCustomization::AddPropertyWithVisibility(IDetailChildrenBuilder& ChildBuilder, const TSharedPtr<IPropertyHandle>& PropertyHandle, bool bVisible)
-{
-	IDetailPropertyRow& PropertyRow = ChildBuilder.AddProperty(PropertyHandle.ToSharedRef());
-	PropertyRow.Visibility(TAttribute<EVisibility>::Create(TAttribute<EVisibility>::FGetter::CreateLambda([=]()
-	{
-		return bVisible ? EVisibility::Visible : EVisibility::Collapsed;
-	})));
+	// Add with conditional visibility
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, ForwardLeft)), Is8Way);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, ForwardRight)), Is8Way);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, Left)), IsLateral);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, Right)), IsLateral);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, BackwardTurnLeft)), [] { return true; });
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, BackwardTurnRight)), [] { return true; });
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, BackwardLeft)), Is8Way);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, BackwardRight)), Is8Way);
+	AddPropertyWithVisibility(ChildBuilder, PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FSimpleTurnLocoSet, CardinalType)), [bDisableCardinalType] { return !bDisableCardinalType; });
 }
\ No newline at end of file
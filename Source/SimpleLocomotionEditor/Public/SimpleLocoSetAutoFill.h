@@ -0,0 +1,67 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Engine/DeveloperSettings.h"
+#include "SimpleLocoSetAutoFill.generated.h"
+
+class IPropertyHandle;
+class IPropertyUtilities;
+
+/**
+ * Naming conventions used to auto fill strafe gait sets from the asset registry
+ */
+UCLASS(Config=Editor, DefaultConfig, meta=(DisplayName="Simple Locomotion Auto Fill"))
+class SIMPLELOCOMOTIONEDITOR_API USimpleLocoSetAutoFillSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	USimpleLocoSetAutoFillSettings();
+
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+	/**
+	 * Animation sequence name pattern, matching is case-insensitive
+	 * * and ? are wildcards, {State} {Stance} {Gait} and {Cardinal} are replaced by the aliases below
+	 * Omitted tokens resolve to Simple.State.Default and Simple.Stance.Stand
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=AutoFill)
+	FString NamePattern;
+
+	/** Content paths to search recursively, searches all content if empty */
+	UPROPERTY(Config, EditAnywhere, Category=AutoFill, meta=(LongPackageName))
+	TArray<FDirectoryPath> SearchPaths;
+
+	/**
+	 * Name tokens for each tag, separate alternatives with | e.g. Fwd|Forward
+	 * Tags without an alias use the last part of the tag, e.g. Simple.Gait.Walk is Walk
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=AutoFill, meta=(Categories="Simple"))
+	TMap<FGameplayTag, FString> Aliases;
+
+	/** Replace animations that are already assigned */
+	UPROPERTY(Config, EditAnywhere, Category=AutoFill)
+	bool bOverwriteExisting = false;
+};
+
+/**
+ * Fills FSimpleStrafeGaitSet and FSimpleStateToStanceToStrafeGaitSet from animation names
+ * The asset registry is queried and matched on a worker thread without loading anything, only the matched
+ * sequences are loaded asynchronously before they are assigned. Gaps are reported to the SimpleLocomotion message log
+ */
+class SIMPLELOCOMOTIONEDITOR_API FSimpleLocoSetAutoFill
+{
+public:
+	static const FName MessageLogName;
+
+	/** PropertyHandle must be a FSimpleStrafeGaitSet or FSimpleStateToStanceToStrafeGaitSet */
+	static void Run(const TSharedRef<IPropertyHandle>& PropertyHandle, const TSharedPtr<IPropertyUtilities>& PropertyUtilities);
+
+	static bool IsRunning() { return NumRunning > 0; }
+
+private:
+	static int32 NumRunning;
+};
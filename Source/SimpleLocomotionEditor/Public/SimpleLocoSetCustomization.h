@@ -0,0 +1,38 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "IPropertyTypeCustomization.h"
+
+class IDetailChildrenBuilder;
+
+/**
+ * Shared base for loco set customizations that show or hide animations based on the set's Mode
+ * Mode is read from the property's raw data and cached, visibility is evaluated lazily from the cache
+ * so changing Mode doesn't rebuild the details panel
+ */
+class SIMPLELOCOMOTIONEDITOR_API FSimpleLocoSetCustomization : public IPropertyTypeCustomization
+{
+public:
+	virtual void CustomizeHeader(TSharedRef<IPropertyHandle> PropertyHandle, FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& CustomizationUtils) override;
+
+protected:
+	/** Add the Mode property and keep CachedMode in sync with it */
+	void AddModeProperty(IDetailChildrenBuilder& ChildBuilder, const TSharedPtr<IPropertyHandle>& InModeProperty);
+
+	/** Read Mode from raw data, multiple differing values result in an empty tag */
+	void CacheMode();
+
+	bool IsMode(const FGameplayTag& Tag) const { return CachedMode == Tag; }
+
+	/** Read a bool from raw data, true only if every selected struct is true */
+	static bool GetBoolValue(const TSharedPtr<IPropertyHandle>& PropertyHandle);
+
+	/** IsVisible is evaluated lazily, it must only depend on CachedMode or values that can't change while the panel is open */
+	void AddPropertyWithVisibility(IDetailChildrenBuilder& ChildBuilder, const TSharedPtr<IPropertyHandle>& PropertyHandle, TFunction<bool()> IsVisible);
+
+	TSharedPtr<IPropertyHandle> ModeProperty;
+	FGameplayTag CachedMode;
+};
@@ -23,6 +23,12 @@ public class SimpleLocomotionEditor : ModuleRules
                 "PropertyEditor",
                 "SimpleLocomotion",
                 "GameplayTags",
+                "AssetRegistry",
+                "DeveloperSettings",
+                "UnrealEd",
+                "MessageLog",
+                "Kismet",
+                "KismetCompiler",
             }
         );
     }
@@ -0,0 +1,5 @@
+﻿// Copyright (c) Jared Taylor
+
+#include "SimpleLocomotionMover.h"
+
+IMPLEMENT_MODULE(FSimpleLocomotionMoverModule, SimpleLocomotionMover)
\ No newline at end of file
@@ -0,0 +1,136 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "SimpleMoverAnimComponent.h"
+
+#include "SimpleTags.h"
+#include "GameFramework/Pawn.h"
+
+#if WITH_SIMPLE_MOVER
+#include "MoverComponent.h"
+#include "MoverDataModelTypes.h"
+#include "MoverSimulationTypes.h"
+#include "MoverTypes.h"
+#include "MoveLibrary/FloorQueryUtils.h"
+#include "DefaultMovementSet/Settings/CommonLegacyMovementSettings.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(SimpleMoverAnimComponent)
+
+void USimpleMoverAnimComponent::SetUpdatedCharacter()
+{
+	Pawn = Cast<APawn>(GetOwner());
+#if WITH_SIMPLE_MOVER
+	MoverComponent = Pawn ? Pawn->FindComponentByClass<UMoverComponent>() : nullptr;
+	ensureMsgf(MoverComponent, TEXT("%s requires a pawn owner with a UMoverComponent, %s has none"), *GetName(), *GetNameSafe(GetOwner()));
+#endif
+	MoverFrame = {};
+}
+
+const FSimpleMoverFrame& USimpleMoverAnimComponent::GetMoverFrame() const
+{
+	if (MoverFrame.FrameCounter != GFrameCounter)
+	{
+		ReadMoverFrame();
+		MoverFrame.FrameCounter = GFrameCounter;
+	}
+	return MoverFrame;
+}
+
+void USimpleMoverAnimComponent::ReadMoverFrame() const
+{
+#if WITH_SIMPLE_MOVER
+	const UMoverComponent* Mover = Cast<UMoverComponent>(MoverComponent);
+	if (!Mover)
+	{
+		return;
+	}
+	const FMoverSyncState& SyncState = Mover->GetSyncState();
+
+	MoverFrame.MovementMode = SyncState.MovementMode;
+	if (const FMoverDefaultSyncState* DefaultState = SyncState.SyncStateCollection.FindDataByType<FMoverDefaultSyncState>())
+	{
+		MoverFrame.Velocity = DefaultState->GetVelocity_WorldSpace();
+	}
+
+	const UCommonLegacyMovementSettings* Settings = Mover->FindSharedSettings<UCommonLegacyMovementSettings>();
+	MoverFrame.MaxSpeed = Settings ? Settings->MaxSpeed : 0.f;
+	MoverFrame.Acceleration = Settings ? Mover->GetMovementIntent() * Settings->Acceleration : FVector::ZeroVector;
+	MoverFrame.GravityZ = Mover->GetGravityAcceleration().Z;
+	MoverFrame.BrakingDeceleration = Settings ? Settings->Deceleration : 0.f;
+	MoverFrame.BrakingFriction = Settings ? Settings->GroundFriction : 0.f;
+
+	FFloorCheckResult FloorResult;
+	const UMoverBlackboard* Blackboard = Mover->GetSimBlackboard();
+	MoverFrame.bIsCurrentFloorWalkable = !Blackboard || !Blackboard->TryGet(CommonBlackboard::LastFloorResult, FloorResult) ||
+		FloorResult.IsWalkableFloor();
+#endif
+}
+
+void USimpleMoverAnimComponent::GatherSimpleSnapshot(FSimpleLocomotionSnapshot& Snapshot) const
+{
+	// The getters dereference Pawn and read the Mover frame
+	if (!GetSimpleOwnerHasInitialized())
+	{
+		return;
+	}
+	GatherSimpleSnapshotFor(*this, *GetOwner(), Snapshot);
+}
+
+FRotator USimpleMoverAnimComponent::GetSimpleControlRotation() const
+{
+	return Pawn ? Pawn->GetControlRotation() : FRotator::ZeroRotator;
+}
+
+FRotator USimpleMoverAnimComponent::GetSimpleBaseAimRotation() const
+{
+	return Pawn ? Pawn->GetBaseAimRotation() : FRotator::ZeroRotator;
+}
+
+FSimpleGaitSpeed USimpleMoverAnimComponent::GetSimpleMaxGaitSpeeds() const
+{
+	const float MaxWalkSpeed = GetMoverFrame().MaxSpeed;
+	
+	TMap<FGameplayTag, float> MaxSpeeds;
+	MaxSpeeds.Add(FSimpleTags::Simple_Gait_Walk, MaxWalkSpeed);
+	MaxSpeeds.Add(FSimpleTags::Simple_Gait_Run, MaxWalkSpeed);
+	MaxSpeeds.Add(FSimpleTags::Simple_Gait_Sprint, MaxWalkSpeed);
+	return FSimpleGaitSpeed { MaxSpeeds };
+}
+
+bool USimpleMoverAnimComponent::GetSimpleIsMovingOnGround() const
+{
+#if WITH_SIMPLE_MOVER
+	return IsMovementMode(DefaultModeNames::Walking);
+#else
+	return true;
+#endif
+}
+
+bool USimpleMoverAnimComponent::GetSimpleIsFalling() const
+{
+#if WITH_SIMPLE_MOVER
+	return IsMovementMode(DefaultModeNames::Falling);
+#else
+	return false;
+#endif
+}
+
+bool USimpleMoverAnimComponent::GetSimpleMovementIs3D() const
+{
+#if WITH_SIMPLE_MOVER
+	return IsMovementMode(DefaultModeNames::Flying) || IsMovementMode(DefaultModeNames::Swimming);
+#else
+	return false;
+#endif
+}
+
+ENetRole USimpleMoverAnimComponent::GetSimpleLocalRole() const
+{
+	return Pawn ? Pawn->GetLocalRole() : ROLE_None;
+}
+
+bool USimpleMoverAnimComponent::GetSimpleIsLocallyControlled() const
+{
+	return Pawn && Pawn->IsLocallyControlled();
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SimpleAnimComponent.h"
+#include "SimpleMoverAnimComponent.generated.h"
+
+class APawn;
+
+/** Mover state read once per frame by USimpleMoverAnimComponent */
+struct FSimpleMoverFrame
+{
+	uint64 FrameCounter = MAX_uint64;
+	
+	FVector Velocity = FVector::ZeroVector;
+	FVector Acceleration = FVector::ZeroVector;
+	FName MovementMode = NAME_None;
+	float MaxSpeed = 0.f;
+	float GravityZ = 0.f;
+	float BrakingDeceleration = 0.f;
+	float BrakingFriction = 0.f;
+	bool bIsCurrentFloorWalkable = true;
+};
+
+/**
+ * Ready-made USimpleAnimComponent for a pawn driven by Mover 2.0 (UE5.4+)
+ * The Mover sync state is read once per frame and the engine-backed getters are final, so the gather is devirtualized
+ * Project-specific inputs (state, gaits, stances) remain virtual for you to override
+ *
+ * Acceleration is derived from the movement intent, Mover does not track it
+ */
+UCLASS(Blueprintable, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class SIMPLELOCOMOTIONMOVER_API USimpleMoverAnimComponent : public USimpleAnimComponent
+{
+	GENERATED_BODY()
+
+protected:
+	UPROPERTY(Transient, DuplicateTransient)
+	TObjectPtr<APawn> Pawn = nullptr;
+
+	/** UMoverComponent, typed loosely so this header does not require the Mover plugin */
+	UPROPERTY(Transient, DuplicateTransient)
+	TObjectPtr<UActorComponent> MoverComponent = nullptr;
+
+	mutable FSimpleMoverFrame MoverFrame;
+
+public:
+	APawn* GetPawn() const { return Pawn; }
+	UActorComponent* GetMoverComponent() const { return MoverComponent; }
+
+	/** The Mover state for this frame, the sync state is only read on the first call each frame */
+	const FSimpleMoverFrame& GetMoverFrame() const;
+
+protected:
+	virtual void SetUpdatedCharacter() override;
+
+	/** Read the Mover sync state into MoverFrame */
+	void ReadMoverFrame() const;
+
+	bool IsMovementMode(const FName& ModeName) const { return GetMoverFrame().MovementMode == ModeName; }
+
+public:
+	virtual void GatherSimpleSnapshot(FSimpleLocomotionSnapshot& Snapshot) const override;
+	virtual UActorComponent* GetSimpleMovementTickComponent() const override { return MoverComponent; }
+
+public:
+	virtual FVector GetSimpleVelocity() const override final { return GetMoverFrame().Velocity; }
+	virtual FVector GetSimpleAcceleration() const override final { return GetMoverFrame().Acceleration; }
+	virtual FRotator GetSimpleControlRotation() const override final;
+	virtual FRotator GetSimpleBaseAimRotation() const override final;
+	virtual float GetSimpleMaxSpeed() const override final { return GetMoverFrame().MaxSpeed; }
+
+	/** Walk, Run and Sprint all use UCommonLegacyMovementSettings::MaxSpeed, override if you have custom gait speeds */
+	virtual FSimpleGaitSpeed GetSimpleMaxGaitSpeeds() const override;
+
+	virtual float GetSimpleGravityZ() const override final { return GetMoverFrame().GravityZ; }
+	virtual float GetSimpleBrakingDeceleration() const override final { return GetMoverFrame().BrakingDeceleration; }
+	virtual float GetSimpleBrakingFriction() const override final { return GetMoverFrame().BrakingFriction; }
+	virtual bool IsSimpleCurrentFloorWalkable() const override final { return GetMoverFrame().bIsCurrentFloorWalkable; }
+	virtual bool GetSimpleIsMovingOnGround() const override final;
+	virtual bool GetSimpleIsFalling() const override final;
+	virtual bool GetSimpleMovementIs3D() const override final;
+	virtual bool GetSimpleIsMoveModeValid() const override final { return !GetMoverFrame().MovementMode.IsNone(); }
+	virtual bool GetSimpleOwnerHasInitialized() const override { return Pawn && MoverComponent; }
+	virtual ENetRole GetSimpleLocalRole() const override final;
+	virtual bool GetSimpleIsLocallyControlled() const override final;
+};
@@ -0,0 +1,65 @@
+﻿// Copyright (c) Jared Taylor
+
+using System.Linq;
+using UnrealBuildTool;
+
+public class SimpleLocomotionMover : ModuleRules
+{
+	public SimpleLocomotionMover(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"SimpleLocomotion",
+			}
+			);
+			
+		
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"CoreUObject",
+				"Engine",
+				"GameplayTags",
+			}
+			);
+
+		// Mover is experimental and only ships with 5.4+, without it this module compiles to an inert component
+		bool bWithMover = IsMoverEnabled(Target);
+		if (bWithMover)
+		{
+			PrivateDependencyModuleNames.Add("Mover");
+		}
+		PublicDefinitions.Add("WITH_SIMPLE_MOVER=" + (bWithMover ? "1" : "0"));
+	}
+
+	/** Mover is never force-enabled by this plugin, the project or target must enable it */
+	private static bool IsMoverEnabled(ReadOnlyTargetRules Target)
+	{
+		if (Target.Version.MajorVersion < 5 || (Target.Version.MajorVersion == 5 && Target.Version.MinorVersion < 4))
+		{
+			return false;
+		}
+
+		if (Target.DisablePlugins.Contains("Mover"))
+		{
+			return false;
+		}
+
+		if (Target.EnablePlugins.Contains("Mover"))
+		{
+			return true;
+		}
+
+		if (Target.ProjectFile == null)
+		{
+			return false;
+		}
+
+		ProjectDescriptor Project = ProjectDescriptor.FromFile(Target.ProjectFile);
+		return Project.Plugins != null && Project.Plugins.Any(Plugin => Plugin.Name == "Mover" && Plugin.bEnabled);
+	}
+}